@@ -16,7 +16,28 @@
                    'src/PartitionController.cpp',
                    'src/ExpirationInfo.cpp',
                    'src/RowKeyPredicate.cpp',
-                   'src/QueryAnalysisEntry.cpp'],
+                   'src/QueryAnalysisEntry.cpp',
+                   'src/StorePool.cpp',
+                   'src/PartitionCache.cpp',
+                   'src/ContainerSchema.cpp',
+                   'src/RowKeyList.cpp',
+                   'src/QueryTemplate.cpp',
+                   'src/PreparedQuery.cpp',
+                   'src/ColumnStats.cpp',
+                   'src/GroupTable.cpp',
+                   'src/FieldValue.cpp',
+                   'src/TopKMerger.cpp',
+                   'src/Sketch.cpp',
+                   'src/StatsSketch.cpp',
+                   'src/Downsample.cpp',
+                   'src/RowCache.cpp',
+                   'src/Metrics.cpp',
+                   'src/Tracing.cpp',
+                   'src/Watchdog.cpp',
+                   'src/ExternalMemory.cpp',
+                   'src/RowPool.cpp',
+                   'src/RowView.cpp',
+                   'src/PackedLayout.cpp'],
       'include_dirs': ["<!@(node -p \"require('node-addon-api').include\")",
                        "include/"],
       'dependencies': ["<!(node -p \"require('node-addon-api').gyp\")"],
@@ -15,6 +15,7 @@
 */
 
 var griddb = require('./griddb');
+const { performance } = require('perf_hooks');
 
 // Export enum values
 const griddbconst = {
@@ -78,4 +79,130 @@ for (var key in griddbconst) {
     griddb[key] = griddbconst[key];
 }
 
+// Async iterator over container names of all partitions.
+// options: pattern (LIKE pattern, '%' and '_' wildcards), concurrency, pageSize
+// Partitions are read in batches in parallel, next batch is prefetched.
+griddb.Store.prototype.listContainers = async function* (options) {
+    const opts = Object.assign({}, options);
+    const concurrency = opts.concurrency || 4;
+    const batchSize = concurrency * 8;
+    let start = 0;
+    let next = this.listContainerNames(start, start + batchSize, opts);
+    while (next !== null) {
+        const result = await next;
+        start += batchSize;
+        next = null;
+        if (start < result.partitionCount) {
+            next = this.listContainerNames(start, start + batchSize, opts);
+            // Not awaited when caller stops early
+            next.catch(() => {});
+        }
+        yield* result.names;
+    }
+};
+
+// Release native handles on leaving `using` / `await using` blocks
+for (const cls of [griddb.Store, griddb.Container, griddb.Query,
+        griddb.RowSet]) {
+    if (typeof Symbol.dispose === 'symbol') {
+        cls.prototype[Symbol.dispose] = function () {
+            this.close();
+        };
+    }
+    if (typeof Symbol.asyncDispose === 'symbol') {
+        cls.prototype[Symbol.asyncDispose] = async function () {
+            this.close();
+        };
+    }
+}
+
+// Give the row of RowSet.nextView() back on leaving a `using` block
+if (typeof Symbol.dispose === 'symbol') {
+    griddb.RowView.prototype[Symbol.dispose] = function () {
+        this.release();
+    };
+}
+
+// Merge RowSets into the first k rows ordered by options.orderBy
+griddb.mergeTopK = griddb.RowSet.mergeTopK;
+
+// Native operations as performance measures named
+// "griddb.<Class>.<method>#<sequence>" with detail {name, container, rows,
+// bytes, error}, where name is "griddb.<Class>.<method>", on the same
+// timeline as "gc" and other entries seen by PerformanceObserver.
+// Measures are removed from the performance timeline once observed.
+// options: interval (ms between drains), bufferSize (spans kept natively
+// between drains)
+const tracing = griddb.tracing;
+let tracingTimer = null;
+let tracingSequence = 0;
+
+tracing.flush = function () {
+    const result = tracing.drain();
+    for (const span of result.spans) {
+        // Unique name, so that only this measure is cleared
+        const name = `${span.name}#${++tracingSequence}`;
+        performance.measure(name, {
+            start: span.startTime,
+            duration: span.duration,
+            detail: Object.assign({ name: span.name }, span.detail)
+        });
+        performance.clearMeasures(name);
+    }
+    return result.dropped;
+};
+
+tracing.enable = function (options) {
+    const opts = Object.assign({ interval: 100, bufferSize: 4096 }, options);
+    tracing.disable();
+    tracing.start(performance.now(), opts.bufferSize);
+    tracingTimer = setInterval(tracing.flush, opts.interval);
+    tracingTimer.unref();
+};
+
+tracing.disable = function () {
+    if (tracingTimer !== null) {
+        clearInterval(tracingTimer);
+        tracingTimer = null;
+        tracing.stop();
+        tracing.flush();
+    }
+};
+
+// Report binding calls blocking the JS thread longer than threshold ms.
+// options: threshold, callback (called with each {method, duration, args}
+// report, asynchronously), interval (ms between deliveries). Totals by
+// method are kept by watchdog.stats() with or without a callback
+const watchdog = griddb.watchdog;
+let watchdogTimer = null;
+let watchdogCallback = null;
+
+watchdog.flush = function () {
+    const reports = watchdog.drain();
+    if (watchdogCallback !== null) {
+        for (const report of reports) {
+            watchdogCallback(report);
+        }
+    }
+};
+
+watchdog.enable = function (options) {
+    const opts = Object.assign({ threshold: 50, interval: 100 }, options);
+    watchdog.disable();
+    watchdog.start(opts.threshold);
+    watchdogCallback = opts.callback || null;
+    watchdogTimer = setInterval(watchdog.flush, opts.interval);
+    watchdogTimer.unref();
+};
+
+watchdog.disable = function () {
+    if (watchdogTimer !== null) {
+        clearInterval(watchdogTimer);
+        watchdogTimer = null;
+        watchdog.stop();
+        watchdog.flush();
+        watchdogCallback = null;
+    }
+};
+
 module.exports = griddb;
@@ -21,9 +21,16 @@
 #include "ExpirationInfo.h"
 #include "AggregationResult.h"
 #include "Container.h"
+#include "Metrics.h"
+#include "Tracing.h"
+#include "Watchdog.h"
+#include "ExternalMemory.h"
 #include "PartitionController.h"
 #include "Query.h"
+#include "PreparedQuery.h"
 #include "RowSet.h"
+#include "RowView.h"
+#include "StatsSketch.h"
 #include "Store.h"
 #include "RowKeyPredicate.h"
 #include "QueryAnalysisEntry.h"
@@ -46,9 +53,16 @@ Napi::Object init(Napi::Env env, Napi::Object exports) {
     Container::init(env, exports);
     PartitionController::init(env, exports);
     Query::init(env, exports);
+    PreparedQuery::init(env, exports);
     RowSet::init(env, exports);
+    RowView::init(env, exports);
+    StatsSketch::init(env, exports);
     RowKeyPredicate::init(env, exports);
     QueryAnalysisEntry::init(env, exports);
+    Metrics::init(env, exports);
+    Tracing::init(env, exports);
+    Watchdog::init(env, exports);
+    ExternalMemory::init(env, exports);
     return exports;
 }
 
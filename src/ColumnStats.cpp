@@ -0,0 +1,329 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "ColumnStats.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#if defined(__AVX2__)
+#define COLUMN_STATS_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLUMN_STATS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace griddb {
+
+template<typename V, typename T,
+        GSResult (GS_API_CALL *GET)(GSRow*, int32_t, T*)>
+static GSResult readNumber(GSRow *row, int column, V *value,
+        bool *isNull) {
+    T fieldValue;
+    GSResult ret = GET(row, column, &fieldValue);
+    if (!GS_SUCCEEDED(ret)) {
+        return ret;
+    }
+    *value = static_cast<V>(fieldValue);
+    *isNull = false;
+    if (fieldValue == 0) {
+        // NULL field is read as 0
+        GSBool nullValue;
+        ret = gsGetRowFieldNull(row, column, &nullValue);
+        *isNull = GS_SUCCEEDED(ret) && nullValue == GS_TRUE;
+    }
+    return ret;
+}
+
+ReadNumberFunc ColumnStats::numberReader(GSType type) {
+    switch (type) {
+    case GS_TYPE_BYTE:
+        return readNumber<double, int8_t, gsGetRowFieldAsByte>;
+    case GS_TYPE_SHORT:
+        return readNumber<double, int16_t, gsGetRowFieldAsShort>;
+    case GS_TYPE_INTEGER:
+        return readNumber<double, int32_t, gsGetRowFieldAsInteger>;
+    case GS_TYPE_LONG:
+        return readNumber<double, int64_t, gsGetRowFieldAsLong>;
+    case GS_TYPE_FLOAT:
+        return readNumber<double, float, gsGetRowFieldAsFloat>;
+    case GS_TYPE_DOUBLE:
+        return readNumber<double, double, gsGetRowFieldAsDouble>;
+    case GS_TYPE_TIMESTAMP:
+        return readNumber<double, GSTimestamp, gsGetRowFieldAsTimestamp>;
+    default:
+        return NULL;
+    }
+}
+
+ReadIntegerFunc ColumnStats::integerReader(GSType type) {
+    switch (type) {
+    case GS_TYPE_BYTE:
+        return readNumber<int64_t, int8_t, gsGetRowFieldAsByte>;
+    case GS_TYPE_SHORT:
+        return readNumber<int64_t, int16_t, gsGetRowFieldAsShort>;
+    case GS_TYPE_INTEGER:
+        return readNumber<int64_t, int32_t, gsGetRowFieldAsInteger>;
+    case GS_TYPE_LONG:
+        return readNumber<int64_t, int64_t, gsGetRowFieldAsLong>;
+    case GS_TYPE_TIMESTAMP:
+        return readNumber<int64_t, GSTimestamp, gsGetRowFieldAsTimestamp>;
+    default:
+        return NULL;
+    }
+}
+
+// Add value to *sum, false without changing it on overflow
+static bool addExact(int64_t *sum, int64_t value) {
+    if ((value > 0 && *sum > std::numeric_limits<int64_t>::max() - value) ||
+            (value < 0 &&
+            *sum < std::numeric_limits<int64_t>::min() - value)) {
+        return false;
+    }
+    *sum += value;
+    return true;
+}
+
+// Kernels: sum, min and max of chunk; sum of squared differences from mean
+
+#if COLUMN_STATS_AVX2
+static void reduceSumMinMax(const double *data, size_t count, double *sum,
+        double *min, double *max) {
+    __m256d vsum = _mm256_setzero_pd();
+    __m256d vmin = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    __m256d vmax = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d v = _mm256_loadu_pd(data + i);
+        vsum = _mm256_add_pd(vsum, v);
+        vmin = _mm256_min_pd(vmin, v);
+        vmax = _mm256_max_pd(vmax, v);
+    }
+    double lane[3][4];
+    _mm256_storeu_pd(lane[0], vsum);
+    _mm256_storeu_pd(lane[1], vmin);
+    _mm256_storeu_pd(lane[2], vmax);
+    *sum = lane[0][0] + lane[0][1] + lane[0][2] + lane[0][3];
+    *min = std::min(std::min(lane[1][0], lane[1][1]),
+            std::min(lane[1][2], lane[1][3]));
+    *max = std::max(std::max(lane[2][0], lane[2][1]),
+            std::max(lane[2][2], lane[2][3]));
+    for (; i < count; i++) {
+        *sum += data[i];
+        *min = std::min(*min, data[i]);
+        *max = std::max(*max, data[i]);
+    }
+}
+
+static double reduceSquaredDiff(const double *data, size_t count,
+        double mean) {
+    __m256d vmean = _mm256_set1_pd(mean);
+    __m256d vsum = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d d = _mm256_sub_pd(_mm256_loadu_pd(data + i), vmean);
+        vsum = _mm256_add_pd(vsum, _mm256_mul_pd(d, d));
+    }
+    double lane[4];
+    _mm256_storeu_pd(lane, vsum);
+    double sum = lane[0] + lane[1] + lane[2] + lane[3];
+    for (; i < count; i++) {
+        sum += (data[i] - mean) * (data[i] - mean);
+    }
+    return sum;
+}
+#elif COLUMN_STATS_SSE2
+static void reduceSumMinMax(const double *data, size_t count, double *sum,
+        double *min, double *max) {
+    __m128d vsum = _mm_setzero_pd();
+    __m128d vmin = _mm_set1_pd(std::numeric_limits<double>::infinity());
+    __m128d vmax = _mm_set1_pd(-std::numeric_limits<double>::infinity());
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128d v = _mm_loadu_pd(data + i);
+        vsum = _mm_add_pd(vsum, v);
+        vmin = _mm_min_pd(vmin, v);
+        vmax = _mm_max_pd(vmax, v);
+    }
+    double lane[3][2];
+    _mm_storeu_pd(lane[0], vsum);
+    _mm_storeu_pd(lane[1], vmin);
+    _mm_storeu_pd(lane[2], vmax);
+    *sum = lane[0][0] + lane[0][1];
+    *min = std::min(lane[1][0], lane[1][1]);
+    *max = std::max(lane[2][0], lane[2][1]);
+    for (; i < count; i++) {
+        *sum += data[i];
+        *min = std::min(*min, data[i]);
+        *max = std::max(*max, data[i]);
+    }
+}
+
+static double reduceSquaredDiff(const double *data, size_t count,
+        double mean) {
+    __m128d vmean = _mm_set1_pd(mean);
+    __m128d vsum = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128d d = _mm_sub_pd(_mm_loadu_pd(data + i), vmean);
+        vsum = _mm_add_pd(vsum, _mm_mul_pd(d, d));
+    }
+    double lane[2];
+    _mm_storeu_pd(lane, vsum);
+    double sum = lane[0] + lane[1];
+    for (; i < count; i++) {
+        sum += (data[i] - mean) * (data[i] - mean);
+    }
+    return sum;
+}
+#else
+static void reduceSumMinMax(const double *data, size_t count, double *sum,
+        double *min, double *max) {
+    *sum = 0;
+    *min = std::numeric_limits<double>::infinity();
+    *max = -std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < count; i++) {
+        *sum += data[i];
+        *min = std::min(*min, data[i]);
+        *max = std::max(*max, data[i]);
+    }
+}
+
+static double reduceSquaredDiff(const double *data, size_t count,
+        double mean) {
+    double sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += (data[i] - mean) * (data[i] - mean);
+    }
+    return sum;
+}
+#endif
+
+ColumnStats::ColumnStats() : mCount(0), mSum(0), mIntegerSum(0),
+        mExact(true), mMin(std::numeric_limits<double>::infinity()),
+        mMax(-std::numeric_limits<double>::infinity()), mMean(0), mM2(0) {
+}
+
+void ColumnStats::add(double value) {
+    mCount++;
+    mSum += value;
+    mMin = std::min(mMin, value);
+    mMax = std::max(mMax, value);
+    double delta = value - mMean;
+    mMean += delta / mCount;
+    mM2 += delta * (value - mMean);
+    mExact = false;
+}
+
+void ColumnStats::addInteger(int64_t value) {
+    bool exact = mExact && addExact(&mIntegerSum, value);
+    add(static_cast<double>(value));
+    mExact = exact;
+}
+
+/**
+ * @brief Add chunk of values: reduce it with kernels, then merge it
+ * @param *data Values
+ * @param count Number of values
+ */
+void ColumnStats::addChunk(const double *data, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    ColumnStats chunk;
+    reduceSumMinMax(data, count, &chunk.mSum, &chunk.mMin, &chunk.mMax);
+    chunk.mCount = count;
+    chunk.mMean = chunk.mSum / count;
+    chunk.mM2 = reduceSquaredDiff(data, count, chunk.mMean);
+    chunk.mExact = false;
+    merge(chunk);
+}
+
+/**
+ * @brief Add chunk of integral values, their sum is kept exactly
+ * @param *data Values
+ * @param count Number of values
+ */
+void ColumnStats::addIntegerChunk(const int64_t *data, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    std::vector<double> values(data, data + count);
+    ColumnStats chunk;
+    chunk.addChunk(values.data(), count);
+    chunk.mExact = true;
+    for (size_t i = 0; i < count && chunk.mExact; i++) {
+        chunk.mExact = addExact(&chunk.mIntegerSum, data[i]);
+    }
+    merge(chunk);
+}
+
+/**
+ * @brief Merge statistics of other values into this
+ */
+void ColumnStats::merge(const ColumnStats &other) {
+    if (other.mCount == 0) {
+        return;
+    }
+    if (mCount == 0) {
+        *this = other;
+        return;
+    }
+    uint64_t count = mCount + other.mCount;
+    double delta = other.mMean - mMean;
+    mMean += delta * other.mCount / count;
+    mM2 += other.mM2 + delta * delta *
+            (static_cast<double>(mCount) * other.mCount / count);
+    mCount = count;
+    mSum += other.mSum;
+    mExact = mExact && other.mExact &&
+            addExact(&mIntegerSum, other.mIntegerSum);
+    mMin = std::min(mMin, other.mMin);
+    mMax = std::max(mMax, other.mMax);
+}
+
+uint64_t ColumnStats::count() const {
+    return mCount;
+}
+
+double ColumnStats::sum() const {
+    return mExact ? static_cast<double>(mIntegerSum) : mSum;
+}
+
+double ColumnStats::min() const {
+    return mMin;
+}
+
+double ColumnStats::max() const {
+    return mMax;
+}
+
+double ColumnStats::mean() const {
+    return mMean;
+}
+
+double ColumnStats::variance() const {
+    return mCount > 1 ? mM2 / (mCount - 1) : 0;
+}
+
+double ColumnStats::stddev() const {
+    return std::sqrt(variance());
+}
+
+}  // namespace griddb
@@ -0,0 +1,80 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef COLUMNSTATS_H
+#define COLUMNSTATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "gridstore.h"
+
+// Number of values of one column converted before running kernels
+#define COLUMN_CHUNK_SIZE 4096
+
+namespace griddb {
+
+// Read numeric field as double. *isNull is set for NULL field
+typedef GSResult (*ReadNumberFunc)(GSRow *row, int column, double *value,
+        bool *isNull);
+// Read integral field as int64_t. *isNull is set for NULL field
+typedef GSResult (*ReadIntegerFunc)(GSRow *row, int column, int64_t *value,
+        bool *isNull);
+
+// Running count, sum, min, max and variance of numeric column values.
+// Values are added in chunks, which are reduced with SIMD kernels when
+// built with SSE2 or AVX2, otherwise with scalar loops. Sum of integral
+// values is kept exactly as int64_t until it overflows
+class ColumnStats {
+ public:
+    ColumnStats();
+
+    // Reader for column type, NULL for not numeric type
+    static ReadNumberFunc numberReader(GSType type);
+    // Reader for integral column type, NULL for other types
+    static ReadIntegerFunc integerReader(GSType type);
+
+    void add(double value);
+    void addChunk(const double *data, size_t count);
+    void addInteger(int64_t value);
+    void addIntegerChunk(const int64_t *data, size_t count);
+    void merge(const ColumnStats &other);
+
+    uint64_t count() const;
+    double sum() const;
+    double min() const;
+    double max() const;
+    double mean() const;
+    // Sample variance and standard deviation, need two values at least
+    double variance() const;
+    double stddev() const;
+
+ private:
+    uint64_t mCount;
+    double mSum;
+    // Exact sum, valid while mExact is set: all values are integral and
+    // their sum has not overflowed
+    int64_t mIntegerSum;
+    bool mExact;
+    double mMin;
+    double mMax;
+    double mMean;
+    // Sum of squared differences from mean
+    double mM2;
+};
+
+}  // namespace griddb
+
+#endif  // COLUMNSTATS_H
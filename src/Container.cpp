@@ -15,7 +15,18 @@
 */
 
 #include "Container.h"
+#include <cmath>
+#include <limits>
 #include <string>
+#include <unordered_map>
+#include <vector>
+#include "ExternalMemory.h"
+#include "Metrics.h"
+#include "Tracing.h"
+#include "PackedLayout.h"
+#include "PreparedQuery.h"
+#include "RowKeyList.h"
+#include "Watchdog.h"
 
 namespace griddb {
 
@@ -29,10 +40,14 @@ Napi::Object Container::init(Napi::Env env, Napi::Object exports) {
     Napi::Function func = DefineClass(env, "Container",
             {   InstanceMethod("put", &Container::put),
                 InstanceMethod("query", &Container::query),
+                InstanceMethod("prepare", &Container::prepare),
                 InstanceMethod("get", &Container::get),
+                InstanceMethod("getMany", &Container::getMany),
                 InstanceMethod("queryByTimeSeriesRange",
                     &Container::queryByTimeSeriesRange),
                 InstanceMethod("multiPut", &Container::multiPut),
+                InstanceMethod("putPacked", &Container::putPacked),
+                InstanceMethod("packedLayout", &Container::packedLayout),
                 InstanceMethod("createIndex", &Container::createIndex),
                 InstanceMethod("dropIndex", &Container::dropIndex),
                 InstanceMethod("flush", &Container::flush),
@@ -40,6 +55,7 @@ Napi::Object Container::init(Napi::Env env, Napi::Object exports) {
                 InstanceMethod("commit", &Container::commit),
                 InstanceMethod("setAutoCommit", &Container::setAutoCommit),
                 InstanceMethod("remove", &Container::remove),
+                InstanceMethod("close", &Container::close),
                 InstanceAccessor("type", &Container::getType, nullptr)
             });
 
@@ -55,40 +71,29 @@ Napi::Object Container::init(Napi::Env env, Napi::Object exports) {
     return exports;
 }
 
-static void freeMemoryContainer(GSContainerInfo** containerInfo,
-        GSType** typeList) {
-    if (*containerInfo) {
-        int columnCount = static_cast<int>((*containerInfo)->columnCount);
-        for (int i = 0; i < columnCount; i++) {
-            if ((*containerInfo)->columnInfoList
-                    && (*containerInfo)->columnInfoList[i].name) {
-                delete[] (*containerInfo)->columnInfoList[i].name;
-            }
-        }
-        if ((*containerInfo)->columnInfoList) {
-            delete[] (*containerInfo)->columnInfoList;
-        }
-        if ((*containerInfo)->name) {
-            delete[] (*containerInfo)->name;
-        }
-        delete (*containerInfo);
-        *containerInfo = NULL;
-    }
-    if (*typeList) {
-        delete[] *typeList;
-        *typeList = NULL;
-    }
-}
-
 Container::Container(const Napi::CallbackInfo &info) :
-        Napi::ObjectWrap<Container>(info) {
+        Napi::ObjectWrap<Container>(info), mContainer(NULL), mRow(NULL),
+        mRowBytes(0) {
     Napi::Env env = info.Env();
-    if (info.Length() != 2 || !info[0].IsExternal() || !info[1].IsExternal()) {
+    if (info.Length() < 2 || info.Length() > 4 || !info[0].IsExternal()
+            || !info[1].IsExternal()
+            || (info.Length() >= 3 && !info[2].IsExternal())
+            || (info.Length() == 4 && !info[3].IsExternal())) {
         // Throw error
         THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", mContainer)
         return;
     }
+    if (info.Length() >= 3) {
+        // Store pool shared with the owner Store
+        mPool = *info[2].As<Napi::External<
+                std::shared_ptr<StorePool> >>().Data();
+    }
+    if (info.Length() == 4) {
+        mRowCache = *info[3].As<Napi::External<
+                std::shared_ptr<RowCache> >>().Data();
+    }
     this->mContainer = info[0].As<Napi::External<GSContainer>>().Data();
+    Metrics::addGauge(GAUGE_OPEN_CONTAINERS, 1);
     GSResult ret = gsCreateRowByContainer(mContainer, &mRow);
     if (!GS_SUCCEEDED(ret)) {
         THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", mContainer)
@@ -98,65 +103,40 @@ Container::Container(const Napi::CallbackInfo &info) :
     GSContainerInfo* containerInfo =
             info[1].As<Napi::External<GSContainerInfo>>().Data();
 
-    GSColumnInfo* columnInfoList;
-    // Create local mContainerInfo: there is issue from C-API about using
+    // Keep own copy of schema: there is issue from C-API about using
     // share memory that make GSContainerInfo* pointer error in case :
-    // create gsRow, get GSContainerInfo from gsRow, set field of gsRow
+    // create gsRow, get GSContainerInfo from gsRow, set field of gsRow.
+    // The copy is shared with other containers having the same schema
     try {
-        mContainerInfo = new GSContainerInfo();
-        (*mContainerInfo) = (*containerInfo);  // For normal data
-        mContainerInfo->name = NULL;
+        mSchema = ContainerSchema::intern(containerInfo,
+                ExternalMemory::account(env));
         if (containerInfo->name) {
-            mContainerInfo->name = Util::strdup(containerInfo->name);
+            mName = containerInfo->name;
         }
-
-        columnInfoList = new GSColumnInfo[containerInfo->columnCount]();
-        mContainerInfo->columnInfoList = columnInfoList;
-
-        for (int i = 0; i < static_cast<int>(containerInfo->columnCount); i++) {
-            columnInfoList[i].type = containerInfo->columnInfoList[i].type;
-            if (containerInfo->columnInfoList[i].name) {
-                columnInfoList[i].name =
-                        Util::strdup(containerInfo->columnInfoList[i].name);
-            } else {
-                columnInfoList[i].name = NULL;
-            }
-
-            columnInfoList[i].indexTypeFlags =
-                    containerInfo->columnInfoList[i].indexTypeFlags;
-            columnInfoList[i].options =
-                    containerInfo->columnInfoList[i].options;
-        }
-
-        mTypeList = new GSType[mContainerInfo->columnCount]();
     } catch (std::bad_alloc&) {
         // Memory allocation error
-        freeMemoryContainer(&mContainerInfo, &mTypeList);
         THROW_EXCEPTION_WITH_STR(env, "Memory allocation error", mContainer)
         return;
     }
-
-    mContainerInfo->timeSeriesProperties = NULL;
-    mContainerInfo->triggerInfoList = NULL;
-    mContainerInfo->dataAffinity = NULL;
-
-    if (mTypeList && mContainerInfo->columnInfoList) {
-        int columnCount = static_cast<int>(mContainerInfo->columnCount);
-        for (int i = 0; i < columnCount; i++) {
-            mTypeList[i] = mContainerInfo->columnInfoList[i].type;
-        }
-    }
+    mRowBytes = mSchema->estimatedRowSize();
+    ExternalMemory::add(env, MEMORY_ROW, mRowBytes);
+    mRowPool.reset(new RowPool(mContainer, mRowBytes,
+            ExternalMemory::account(env)));
 }
 
 Napi::Value Container::put(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Container.put", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    PhaseTimer timer(CALL_CONTAINER_PUT);
+    TraceSpan span("griddb.Container.put");
+    span.setContainer(mName);
     if (info.Length() != 1 || !info[0].IsArray()) {
         // Throw error
         PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mContainer)
     }
     Napi::Array rowWrapper = info[0].As<Napi::Array>();
-    int colNum = mContainerInfo->columnCount;
+    int colNum = static_cast<int>(mSchema->columnCount());
     int length = rowWrapper.Length();
 
     if (length != colNum) {
@@ -166,36 +146,47 @@ Napi::Value Container::put(const Napi::CallbackInfo &info) {
 
     Napi::Value fieldValue;
     for (int k = 0; k < length; k++) {
-        GSType type = mTypeList[k];
         fieldValue = rowWrapper.Get(k);
         try {
-            Util::toField(env, &fieldValue, mRow, k, type);
+            mSchema->toField(env, &fieldValue, mRow, k);
         } catch (const Napi::Error &e) {
             PROMISE_REJECT_WITH_ERROR(deferred, e)
         }
     }
 
+    invalidateCachedRow(mRow);
     GSBool bExists;
+    timer.enter(PHASE_EXECUTE);
+    int64_t startTime = Metrics::begin();
     GSResult ret = gsPutRow(mContainer, NULL, mRow, &bExists);
+    Metrics::record(METRIC_PUT_ROW, mSchema->containerType(), startTime, ret);
+    span.setResult(ret);
+    span.setRows(1);
 
     if (!GS_SUCCEEDED(ret)) {
         PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, mContainer)
     }
+    Metrics::add(COUNTER_ROWS_WRITTEN, 1);
     deferred.Resolve(env.Null());
+    timer.finish(deferred.Promise());
     return deferred.Promise();
 }
 
 Napi::Value Container::query(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Container.query", info);
     if (info.Length() != 1 || !info[0].IsString()) {
         // Throw error
         THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", mContainer)
         return env.Null();
     }
     std::string queryStr = info[0].As<Napi::String>().ToString().Utf8Value();
+    return newQuery(env, queryStr);
+}
 
+Napi::Value Container::newQuery(const Napi::Env &env, const std::string &tql) {
     GSQuery *pQuery;
-    GSResult ret = gsQuery(mContainer, queryStr.c_str(), &pQuery);
+    GSResult ret = gsQuery(mContainer, tql.c_str(), &pQuery);
 
     if (!GS_SUCCEEDED(ret)) {
         THROW_EXCEPTION_WITH_CODE(env, ret, mContainer)
@@ -205,28 +196,73 @@ Napi::Value Container::query(const Napi::CallbackInfo &info) {
     // Create new Query object
     Napi::EscapableHandleScope scope(env);
     auto queryPtr = Napi::External<GSQuery>::New(env, pQuery);
-    auto containerInfoPtr = Napi::External<GSContainerInfo>::New(env,
-            mContainerInfo);
-    auto gsRowPtr = Napi::External<GSRow>::New(env, mRow);
+    auto schemaPtr = Napi::External<ContainerSchema>::New(env,
+            const_cast<ContainerSchema*>(mSchema.get()));
+    auto rowPoolPtr = Napi::External<std::shared_ptr<RowPool> >::New(env,
+            &mRowPool);
+    auto name = Napi::String::New(env, mName);
 
 #if NAPI_VERSION > 5
     return scope.Escape(Util::getInstanceData(env, "Query")->
-            New({queryPtr, containerInfoPtr, gsRowPtr})).ToObject();
+            New({queryPtr, schemaPtr, rowPoolPtr, name})).ToObject();
 #else
-    return scope.Escape(Query::constructor.New( { queryPtr, containerInfoPtr,
-            gsRowPtr })).ToObject();
+    return scope.Escape(Query::constructor.New( { queryPtr, schemaPtr,
+            rowPoolPtr, name })).ToObject();
+#endif
+}
+
+/**
+ * @brief Prepare TQL with "?" parameters. Parsed templates are cached
+ *   per container, so preparing the same TQL again is cheap.
+ * @param info[0] TQL string
+ * @return PreparedQuery object
+ */
+Napi::Value Container::prepare(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() != 1 || !info[0].IsString()) {
+        // Throw error
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", mContainer)
+        return env.Null();
+    }
+    std::shared_ptr<const QueryTemplate> queryTemplate =
+            mTemplateCache.get(info[0].As<Napi::String>().Utf8Value());
+
+    Napi::EscapableHandleScope scope(env);
+    auto templatePtr = Napi::External<std::shared_ptr<const QueryTemplate> >
+            ::New(env, &queryTemplate);
+#if NAPI_VERSION > 5
+    return scope.Escape(Util::getInstanceData(env, "PreparedQuery")->
+            New({Value(), templatePtr})).ToObject();
+#else
+    return scope.Escape(PreparedQuery::constructor.New({Value(),
+            templatePtr})).ToObject();
 #endif
 }
 
 Napi::Value Container::get(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Container.get", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-    if (info.Length() != 1) {
+    PhaseTimer timer(CALL_CONTAINER_GET);
+    TraceSpan span("griddb.Container.get");
+    span.setContainer(mName);
+    if (info.Length() != 1 && info.Length() != 2) {
         // Throw error
         PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mContainer)
     }
+    // Optional columns option: return only these columns
+    std::vector<int> projection;
+    bool projected = false;
+    if (info.Length() == 2) {
+        try {
+            projected = mSchema->toProjectionOption(env, info[1],
+                    &projection);
+        } catch (const Napi::Error &e) {
+            PROMISE_REJECT_WITH_ERROR(deferred, e)
+        }
+    }
     Field field;
-    GSType type = mTypeList[0];
+    GSType type = mSchema->columnType(0);
     Napi::Value fieldValue = info[0].As<Napi::Value>();
     if (!(type == GS_TYPE_STRING || type == GS_TYPE_INTEGER
             || type == GS_TYPE_LONG || type == GS_TYPE_TIMESTAMP)) {
@@ -245,7 +281,7 @@ Napi::Value Container::get(const Napi::CallbackInfo &info) {
 
     switch (type) {
     case GS_TYPE_STRING: {
-        if (mContainerInfo->columnInfoList[0].type != GS_TYPE_STRING
+        if (mSchema->columnType(0) != GS_TYPE_STRING
                 || !info[0].IsString()) {
             PROMISE_REJECT_WITH_STRING(deferred, env,
                     "wrong type of rowKey string", mContainer)
@@ -257,7 +293,7 @@ Napi::Value Container::get(const Napi::CallbackInfo &info) {
         break;
     }
     case GS_TYPE_INTEGER: {
-        if (mContainerInfo->columnInfoList[0].type != GS_TYPE_INTEGER
+        if (mSchema->columnType(0) != GS_TYPE_INTEGER
                 || !info[0].IsNumber()) {
             PROMISE_REJECT_WITH_STRING(deferred, env,
                     "wrong type of rowKey integer", mContainer)
@@ -267,7 +303,7 @@ Napi::Value Container::get(const Napi::CallbackInfo &info) {
         break;
     }
     case GS_TYPE_LONG:
-        if (mContainerInfo->columnInfoList[0].type != GS_TYPE_LONG
+        if (mSchema->columnType(0) != GS_TYPE_LONG
                 || !info[0].IsNumber()) {
             PROMISE_REJECT_WITH_STRING(deferred, env,
                     "wrong type of rowKey long", mContainer)
@@ -276,7 +312,7 @@ Napi::Value Container::get(const Napi::CallbackInfo &info) {
         key = reinterpret_cast<void*>(&tmpLongValue);
         break;
     case GS_TYPE_TIMESTAMP:
-        if (mContainerInfo->columnInfoList[0].type != GS_TYPE_TIMESTAMP) {
+        if (mSchema->columnType(0) != GS_TYPE_TIMESTAMP) {
             PROMISE_REJECT_WITH_STRING(deferred, env,
                     "wrong type of rowKey timestamp", mContainer)
         }
@@ -291,29 +327,274 @@ Napi::Value Container::get(const Napi::CallbackInfo &info) {
         PROMISE_REJECT_WITH_STRING(deferred, env,
                 "wrong type of rowKey field", mContainer)
     }
+    // Serve from row cache without gsGetRow
+    std::string cacheKey;
+    std::vector<FieldValue> cachedRow;
+    bool useCache = rowCacheEnabled();
+    if (useCache) {
+        cacheKey = type == GS_TYPE_STRING ?
+                RowCache::makeKey(mName, tmpString) :
+                RowCache::makeKey(mName, type == GS_TYPE_INTEGER ?
+                        tmpIntValue : type == GS_TYPE_LONG ?
+                        tmpLongValue : tmpTimestampValue);
+        if (mRowCache->get(cacheKey, &cachedRow)) {
+            span.setRows(1);
+            timer.enter(PHASE_BUILD);
+            Napi::Array row;
+            try {
+                if (projected) {
+                    row = Napi::Array::New(env, projection.size());
+                    for (size_t i = 0; i < projection.size(); i++) {
+                        row.Set(static_cast<uint32_t>(i), toNapiValue(env,
+                                cachedRow[projection[i]]));
+                    }
+                } else {
+                    row = Napi::Array::New(env, cachedRow.size());
+                    for (size_t i = 0; i < cachedRow.size(); i++) {
+                        row.Set(static_cast<uint32_t>(i),
+                                toNapiValue(env, cachedRow[i]));
+                    }
+                }
+            } catch (const Napi::Error &e) {
+                PROMISE_REJECT_WITH_ERROR(deferred, e)
+            }
+            deferred.Resolve(row);
+            timer.finish(deferred.Promise());
+            return deferred.Promise();
+        }
+    }
+    timer.enter(PHASE_EXECUTE);
+    int64_t startTime = Metrics::begin();
     ret = gsGetRow(mContainer, key, mRow, &exists);
+    Metrics::record(METRIC_GET_ROW, mSchema->containerType(), startTime, ret);
+    span.setResult(ret);
+    span.setRows(GS_SUCCEEDED(ret) && exists == GS_TRUE ? 1 : 0);
     if (!GS_SUCCEEDED(ret)) {
         PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, mContainer)
     }
     if (exists != GS_TRUE) {
         deferred.Resolve(env.Null());
+        timer.finish(deferred.Promise());
         return deferred.Promise();
     }
+    Metrics::add(COUNTER_ROWS_READ, 1);
+    timer.enter(PHASE_BUILD);
+    if (useCache) {
+        cachedRow.resize(mSchema->columnCount());
+        for (size_t i = 0; i < cachedRow.size() && GS_SUCCEEDED(ret); i++) {
+            ret = readFieldValue(mRow, static_cast<int>(i),
+                    mSchema->columnType(i), &cachedRow[i]);
+        }
+        if (GS_SUCCEEDED(ret)) {
+            mRowCache->put(cacheKey, cachedRow);
+        }
+    }
 
     Napi::Value outputWrapper;
     // Get row data
     try {
-        outputWrapper = Util::fromRow(
-                env, mRow, mContainerInfo->columnCount, mTypeList);
+        if (projected) {
+            outputWrapper = mSchema->fromRow(env, mRow, projection);
+        } else {
+            outputWrapper = mSchema->fromRow(env, mRow);
+        }
     } catch (const Napi::Error &e) {
         PROMISE_REJECT_WITH_ERROR(deferred, e)
     }
     deferred.Resolve(outputWrapper);
+    timer.finish(deferred.Promise());
+    return deferred.Promise();
+}
+
+// Get rows of many keys of one container by a pooled store
+class GetManyWorker : public Napi::AsyncWorker {
+ public:
+    GetManyWorker(Napi::Env env, Napi::Promise::Deferred deferred,
+            std::shared_ptr<StorePool> pool,
+            std::shared_ptr<const ContainerSchema> schema,
+            const std::string &name) :
+            Napi::AsyncWorker(env), mKeyList(schema->columnType(0)),
+            mStore(NULL), mProjected(false), mDeferred(deferred), mPool(pool),
+            mSchema(schema), mName(name), mRowList(NULL), mRowCount(0) {
+    }
+
+    ~GetManyWorker() {
+        for (size_t i = 0; i < mRowCount; i++) {
+            GSRow *row = static_cast<GSRow*>(mRowList[i]);
+            gsCloseRow(&row);
+        }
+        if (mStore) {
+            mPool->release(mStore);
+        }
+    }
+
+    RowKeyList mKeyList;
+    GSGridStore *mStore;
+    std::vector<int> mProjection;
+    bool mProjected;
+
+ protected:
+    void Execute() override {
+        mRowIndexList.assign(mKeyList.size(), -1);
+        if (mKeyList.size() == 0) {
+            return;
+        }
+        GSRowKeyPredicate *predicate;
+        GSResult ret = gsCreateRowKeyPredicate(mStore, mKeyList.type(),
+                &predicate);
+        if (!GS_SUCCEEDED(ret)) {
+            mError.capture(ret, mStore);
+            return;
+        }
+        const GSContainerRowEntry *entryList = NULL;
+        size_t entryCount = 0;
+        ret = mKeyList.addDistinctKeys(predicate);
+        if (GS_SUCCEEDED(ret)) {
+            GSRowKeyPredicateEntry entry;
+            entry.containerName = mName.c_str();
+            entry.predicate = predicate;
+            const GSRowKeyPredicateEntry *predicateList = &entry;
+            int64_t startTime = Metrics::begin();
+            ret = gsGetMultipleContainerRows(mStore, &predicateList, 1,
+                    &entryList, &entryCount);
+            Metrics::record(METRIC_GET_MULTIPLE_CONTAINER_ROWS,
+                    mSchema->containerType(), startTime, ret);
+        }
+        if (!GS_SUCCEEDED(ret)) {
+            mError.capture(ret, predicate);
+            gsCloseRowKeyPredicate(&predicate);
+            return;
+        }
+        gsCloseRowKeyPredicate(&predicate);
+        if (entryCount == 0) {
+            return;
+        }
+        mRowList = entryList[0].rowList;
+        mRowCount = entryList[0].rowCount;
+        Metrics::add(COUNTER_ROWS_READ, mRowCount);
+
+        // Align rows to order of input keys
+        std::unordered_map<int64_t, int64_t> numberIndex;
+        std::unordered_map<std::string, int64_t> stringIndex;
+        int64_t numberKey;
+        std::string stringKey;
+        for (size_t i = 0; i < mRowCount; i++) {
+            ret = mKeyList.getKey(static_cast<GSRow*>(mRowList[i]),
+                    &numberKey, &stringKey);
+            if (!GS_SUCCEEDED(ret)) {
+                mError.capture(ret, mRowList[i]);
+                return;
+            }
+            if (mKeyList.type() == GS_TYPE_STRING) {
+                stringIndex[stringKey] = i;
+            } else {
+                numberIndex[numberKey] = i;
+            }
+        }
+        for (size_t i = 0; i < mKeyList.size(); i++) {
+            if (mKeyList.type() == GS_TYPE_STRING) {
+                auto it = stringIndex.find(mKeyList.stringAt(i));
+                if (it != stringIndex.end()) {
+                    mRowIndexList[i] = it->second;
+                }
+            } else {
+                auto it = numberIndex.find(mKeyList.numberAt(i));
+                if (it != numberIndex.end()) {
+                    mRowIndexList[i] = it->second;
+                }
+            }
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        if (mError.failed()) {
+            Napi::Object obj = GSException::New(env, mError);
+            mDeferred.Reject(Napi::Error(env, obj).Value());
+            return;
+        }
+        Napi::Array result = Napi::Array::New(env, mRowIndexList.size());
+        try {
+            for (size_t i = 0; i < mRowIndexList.size(); i++) {
+                if (mRowIndexList[i] < 0) {
+                    result.Set(static_cast<uint32_t>(i), env.Null());
+                    continue;
+                }
+                GSRow *row = static_cast<GSRow*>(mRowList[mRowIndexList[i]]);
+                if (mProjected) {
+                    result.Set(static_cast<uint32_t>(i),
+                            mSchema->fromRow(env, row, mProjection));
+                } else {
+                    result.Set(static_cast<uint32_t>(i),
+                            mSchema->fromRow(env, row));
+                }
+            }
+        } catch (const Napi::Error &e) {
+            mDeferred.Reject(e.Value());
+            return;
+        }
+        mDeferred.Resolve(result);
+    }
+
+ private:
+    Napi::Promise::Deferred mDeferred;
+    std::shared_ptr<StorePool> mPool;
+    std::shared_ptr<const ContainerSchema> mSchema;
+    std::string mName;
+    void *const *mRowList;
+    size_t mRowCount;
+    std::vector<int64_t> mRowIndexList;
+    GSErrorDetail mError;
+};
+
+/**
+ * @brief Get rows of many row keys with one request.
+ * @param info[0] Array of keys, or Int32Array, Float64Array, BigInt64Array
+ *   for INTEGER, LONG and TIMESTAMP row key
+ * @param info[1] Optional options object. columns: columns of rows
+ * @return Promise of array of rows in order of keys, null for missing key
+ */
+Napi::Value Container::getMany(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    if (info.Length() < 1 || info.Length() > 2
+            || !(info[0].IsArray() || info[0].IsTypedArray())) {
+        PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mContainer)
+    }
+    if (!mSchema->rowKeyAssigned() ||
+            !RowKeyList::isSupported(mSchema->columnType(0))) {
+        PROMISE_REJECT_WITH_STRING(deferred, env, "Invalid key type",
+                mContainer)
+    }
+    if (!mPool) {
+        PROMISE_REJECT_WITH_STRING(deferred, env,
+                "Container is not opened by Store", mContainer)
+    }
+
+    GetManyWorker *worker = new GetManyWorker(env, deferred, mPool, mSchema,
+            mName);
+    try {
+        worker->mKeyList.fromValue(env, info[0]);
+        if (info.Length() == 2) {
+            worker->mProjected = mSchema->toProjectionOption(env, info[1],
+                    &worker->mProjection);
+        }
+    } catch (const Napi::Error &e) {
+        delete worker;
+        PROMISE_REJECT_WITH_ERROR(deferred, e)
+    }
+    GSResult ret = mPool->acquire(&worker->mStore);
+    if (!GS_SUCCEEDED(ret)) {
+        delete worker;
+        PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, NULL)
+    }
+    worker->Queue();
     return deferred.Promise();
 }
 
 Napi::Value Container::queryByTimeSeriesRange(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Container.queryByTimeSeriesRange", info);
     if (info.Length() != 2) {
         // Throw error
         THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", mContainer)
@@ -345,16 +626,18 @@ Napi::Value Container::queryByTimeSeriesRange(const Napi::CallbackInfo &info) {
     // Create new Query object
     Napi::EscapableHandleScope scope(env);
     auto queryPtr = Napi::External<GSQuery>::New(env, pQuery);
-    auto containerInfoPtr = Napi::External<GSContainerInfo>::New(env,
-            mContainerInfo);
-    auto gsRowPtr = Napi::External<GSRow>::New(env, mRow);
+    auto schemaPtr = Napi::External<ContainerSchema>::New(env,
+            const_cast<ContainerSchema*>(mSchema.get()));
+    auto rowPoolPtr = Napi::External<std::shared_ptr<RowPool> >::New(env,
+            &mRowPool);
+    auto name = Napi::String::New(env, mName);
 
 #if NAPI_VERSION > 5
     return scope.Escape(Util::getInstanceData(env, "Query")->
-            New({queryPtr, containerInfoPtr, gsRowPtr})).ToObject();
+            New({queryPtr, schemaPtr, rowPoolPtr, name})).ToObject();
 #else
-    return scope.Escape(Query::constructor.New( { queryPtr, containerInfoPtr,
-            gsRowPtr })).ToObject();
+    return scope.Escape(Query::constructor.New( { queryPtr, schemaPtr,
+            rowPoolPtr, name })).ToObject();
 #endif
 }
 
@@ -363,13 +646,33 @@ Container::~Container() {
         gsCloseRow(&mRow);
         mRow = NULL;
     }
+    if (mRowBytes > 0) {
+        ExternalMemory::remove(Env(), MEMORY_ROW, mRowBytes);
+    }
+    release();
+}
+
+void Container::release() {
     GSBool allRelated = GS_FALSE;
     // Release container and all related resources
     if (mContainer != NULL) {
         gsCloseContainer(&mContainer, allRelated);
         mContainer = NULL;
+        if (mRowPool) {
+            mRowPool->detach();
+        }
+        Metrics::addGauge(GAUGE_OPEN_CONTAINERS, -1);
     }
-    freeMemoryContainer(&mContainerInfo, &mTypeList);
+}
+
+/**
+ * @brief Close the container handle now instead of on GC. Queries and
+ *   RowSets of the container are not closed and keep their own rows.
+ *   Calling again does nothing
+ */
+Napi::Value Container::close(const Napi::CallbackInfo &info) {
+    release();
+    return info.Env().Undefined();
 }
 
 static void freeDataMultiPut(GSRow** listRowdata, int rowCount) {
@@ -383,7 +686,11 @@ static void freeDataMultiPut(GSRow** listRowdata, int rowCount) {
 
 Napi::Value Container::multiPut(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Container.multiPut", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    PhaseTimer timer(CALL_CONTAINER_MULTI_PUT);
+    TraceSpan span("griddb.Container.multiPut");
+    span.setContainer(mName);
     if (info.Length() != 1 || !info[0].IsArray()) {
         PROMISE_REJECT_WITH_STRING(deferred, env,
                 "Expected array of array as input", mContainer)
@@ -416,7 +723,7 @@ Napi::Value Container::multiPut(const Napi::CallbackInfo &info) {
     for (int i = 0; i < rowCount; i++) {
         Napi::Array rowWrapper = rowArrayWrapper.Get(i).As<Napi::Array>();
         length = rowWrapper.Length();
-        if (length != static_cast<int>(mContainerInfo->columnCount)) {
+        if (length != static_cast<int>(mSchema->columnCount())) {
             freeDataMultiPut(listRowdata, rowCount);
             PROMISE_REJECT_WITH_STRING(deferred, env,
                     "Num row is different with container info", mContainer)
@@ -428,10 +735,9 @@ Napi::Value Container::multiPut(const Napi::CallbackInfo &info) {
                     "Can't create GSRow", mContainer)
         }
         for (int k = 0; k < length; k++) {
-            GSType type = mTypeList[k];
             fieldValue = rowWrapper.Get(k);
             try {
-                Util::toField(env, &fieldValue, listRowdata[i], k, type);
+                mSchema->toField(env, &fieldValue, listRowdata[i], k);
             } catch(const Napi::Error& e) {
                 freeDataMultiPut(listRowdata, rowCount);
                 PROMISE_REJECT_WITH_ERROR(deferred, e);
@@ -439,23 +745,161 @@ Napi::Value Container::multiPut(const Napi::CallbackInfo &info) {
         }
     }
 
+    for (int i = 0; i < rowCount; i++) {
+        invalidateCachedRow(listRowdata[i]);
+    }
     GSBool bExists;
     // Data for each container
+    timer.enter(PHASE_EXECUTE);
+    int64_t startTime = Metrics::begin();
     ret = gsPutMultipleRows(mContainer, (const void * const *) listRowdata,
             rowCount, &bExists);
+    Metrics::record(METRIC_PUT_MULTIPLE_ROWS, mSchema->containerType(),
+            startTime, ret);
+    span.setResult(ret);
+    span.setRows(rowCount);
 
+    timer.enter(PHASE_CLEANUP);
     freeDataMultiPut(listRowdata, rowCount);
 
     if (!GS_SUCCEEDED(ret)) {
         PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, mContainer)
     }
+    Metrics::add(COUNTER_ROWS_WRITTEN, rowCount);
 
     deferred.Resolve(env.Null());
+    timer.finish(deferred.Promise());
     return deferred.Promise();
 }
 
+/**
+ * @brief Put rows of one buffer in the format of packedLayout(). Fields
+ *   are read natively, the buffer is not copied
+ * @param info[0] Buffer, Uint8Array or ArrayBuffer
+ * @param info[1] Options {rowCount}, rowCount is a non-negative integer
+ * @return Promise resolved with null
+ */
+Napi::Value Container::putPacked(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("Container.putPacked", info);
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    PhaseTimer timer(CALL_CONTAINER_PUT_PACKED);
+    TraceSpan span("griddb.Container.putPacked");
+    span.setContainer(mName);
+    if (info.Length() != 2 || !info[1].IsObject() ||
+            !info[1].As<Napi::Object>().Get("rowCount").IsNumber()) {
+        PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments",
+                mContainer)
+    }
+    const uint8_t *data = NULL;
+    size_t size = 0;
+    if (info[0].IsTypedArray() && info[0].As<Napi::TypedArray>().
+            TypedArrayType() == napi_uint8_array) {
+        Napi::Uint8Array bytes = info[0].As<Napi::Uint8Array>();
+        data = bytes.Data();
+        size = bytes.ElementLength();
+    } else if (info[0].IsArrayBuffer()) {
+        Napi::ArrayBuffer bytes = info[0].As<Napi::ArrayBuffer>();
+        data = static_cast<const uint8_t*>(bytes.Data());
+        size = bytes.ByteLength();
+    } else {
+        PROMISE_REJECT_WITH_STRING(deferred, env,
+                "Expected Buffer or ArrayBuffer as input", mContainer)
+    }
+    double requestedCount = info[1].As<Napi::Object>().Get("rowCount").
+            As<Napi::Number>().DoubleValue();
+    if (!std::isfinite(requestedCount) || requestedCount < 0 ||
+            requestedCount != std::trunc(requestedCount)) {
+        PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments",
+                mContainer)
+    }
+    PackedLayout layout(*mSchema);
+    if (layout.unsupportedColumn() >= 0) {
+        PROMISE_REJECT_WITH_STRING(deferred, env,
+                "Column type is not supported by packed format", mContainer)
+    }
+    if (requestedCount > std::numeric_limits<int>::max() ||
+            static_cast<uint64_t>(requestedCount) >
+            size / layout.recordSize()) {
+        PROMISE_REJECT_WITH_STRING(deferred, env,
+                "rowCount exceeds buffer size", mContainer)
+    }
+    int rowCount = static_cast<int>(requestedCount);
+    if (rowCount == 0) {
+        deferred.Resolve(env.Null());
+        return deferred.Promise();
+    }
+
+    GSRow **listRowdata;
+    try {
+        listRowdata = new GSRow*[rowCount]();
+    } catch (std::bad_alloc&) {
+        PROMISE_REJECT_WITH_STRING(
+                deferred, env, "Memory allocation error", mContainer)
+    }
+    GSResult ret;
+    std::string buffer;
+    for (int i = 0; i < rowCount; i++) {
+        ret = gsCreateRowByContainer(mContainer, &listRowdata[i]);
+        if (!GS_SUCCEEDED(ret)) {
+            freeDataMultiPut(listRowdata, rowCount);
+            PROMISE_REJECT_WITH_STRING(deferred, env,
+                    "Can't create GSRow", mContainer)
+        }
+        const char *error = layout.readRecord(data, size, rowCount, i,
+                listRowdata[i], &ret, &buffer);
+        if (error != NULL) {
+            std::string message = std::string(error) + " of row " +
+                    std::to_string(i);
+            freeDataMultiPut(listRowdata, rowCount);
+            PROMISE_REJECT_WITH_STRING(deferred, env, message, mContainer)
+        }
+        invalidateCachedRow(listRowdata[i]);
+    }
+
+    GSBool bExists;
+    timer.enter(PHASE_EXECUTE);
+    int64_t startTime = Metrics::begin();
+    ret = gsPutMultipleRows(mContainer, (const void * const *) listRowdata,
+            rowCount, &bExists);
+    Metrics::record(METRIC_PUT_MULTIPLE_ROWS, mSchema->containerType(),
+            startTime, ret);
+    span.setResult(ret);
+    span.setRows(rowCount);
+
+    timer.enter(PHASE_CLEANUP);
+    freeDataMultiPut(listRowdata, rowCount);
+
+    if (!GS_SUCCEEDED(ret)) {
+        PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, mContainer)
+    }
+    Metrics::add(COUNTER_ROWS_WRITTEN, rowCount);
+    Metrics::add(COUNTER_BYTES_WRITTEN, size);
+
+    deferred.Resolve(env.Null());
+    timer.finish(deferred.Promise());
+    return deferred.Promise();
+}
+
+/**
+ * @brief Describe the record layout of putPacked() for this container
+ * @return {recordSize, nullBitmapSize, columns: [{name, type, offset,
+ *   size}]}
+ */
+Napi::Value Container::packedLayout(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    PackedLayout layout(*mSchema);
+    if (layout.unsupportedColumn() >= 0) {
+        THROW_EXCEPTION_WITH_STR(env,
+                "Column type is not supported by packed format", mContainer)
+        return env.Null();
+    }
+    return layout.toObject(env);
+}
+
 Napi::Value Container::createIndex(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Container.createIndex", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
     if (info.Length() != 1 || !info[0].IsObject()) {
         PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mContainer)
@@ -472,13 +916,19 @@ Napi::Value Container::createIndex(const Napi::CallbackInfo &info) {
 
     GSResult ret = GS_RESULT_OK;
     if (name.empty()) {
+        int64_t startTime = Metrics::begin();
         ret = gsCreateIndex(mContainer, columnName.c_str(), indexType);
+        Metrics::record(METRIC_CONTAINER_DDL, mSchema->containerType(),
+                startTime, ret);
     } else {
         GSIndexInfo indexInfo = GS_INDEX_INFO_INITIALIZER;
         indexInfo.name = name.c_str();
         indexInfo.type = indexType;
         indexInfo.columnName = columnName.c_str();
+        int64_t startTime = Metrics::begin();
         ret = gsCreateIndexDetail(mContainer, &indexInfo);
+        Metrics::record(METRIC_CONTAINER_DDL, mSchema->containerType(),
+                startTime, ret);
     }
 
     if (!GS_SUCCEEDED(ret)) {
@@ -491,6 +941,7 @@ Napi::Value Container::createIndex(const Napi::CallbackInfo &info) {
 
 Napi::Value Container::dropIndex(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Container.dropIndex", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
     if (info.Length() != 1 || !info[0].IsObject()) {
         PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mContainer)
@@ -510,13 +961,19 @@ Napi::Value Container::dropIndex(const Napi::CallbackInfo &info) {
     GSResult ret = GS_RESULT_OK;
 
     if (name.empty()) {
+        int64_t startTime = Metrics::begin();
         ret = gsDropIndex(mContainer, columnName.c_str(), indexType);
+        Metrics::record(METRIC_CONTAINER_DDL, mSchema->containerType(),
+                startTime, ret);
     } else {
         GSIndexInfo indexInfo = GS_INDEX_INFO_INITIALIZER;
         indexInfo.name = name.c_str();
         indexInfo.type = indexType;
         indexInfo.columnName = columnName.c_str();
+        int64_t startTime = Metrics::begin();
         ret = gsDropIndexDetail(mContainer, &indexInfo);
+        Metrics::record(METRIC_CONTAINER_DDL, mSchema->containerType(),
+                startTime, ret);
     }
 
     if (!GS_SUCCEEDED(ret)) {
@@ -528,6 +985,7 @@ Napi::Value Container::dropIndex(const Napi::CallbackInfo &info) {
 
 Napi::Value Container::flush(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Container.flush", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
     if (info.Length() != 0) {
         PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mContainer)
@@ -545,12 +1003,17 @@ Napi::Value Container::flush(const Napi::CallbackInfo &info) {
 
 Napi::Value Container::abort(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Container.abort", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
     if (info.Length() != 0) {
         PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mContainer)
     }
 
     GSResult ret = gsAbort(mContainer);
+    // Cached rows may be uncommitted ones
+    if (rowCacheEnabled()) {
+        mRowCache->invalidateContainer(mName);
+    }
 
     if (!GS_SUCCEEDED(ret)) {
         PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, mContainer)
@@ -562,6 +1025,7 @@ Napi::Value Container::abort(const Napi::CallbackInfo &info) {
 
 Napi::Value Container::commit(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Container.commit", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
     if (info.Length() != 0) {
         PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mContainer)
@@ -578,6 +1042,7 @@ Napi::Value Container::commit(const Napi::CallbackInfo &info) {
 
 Napi::Value Container::setAutoCommit(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Container.setAutoCommit", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
     if (info.Length() != 1 || !info[0].IsBoolean()) {
         PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mContainer)
@@ -597,38 +1062,61 @@ Napi::Value Container::setAutoCommit(const Napi::CallbackInfo &info) {
 
 Napi::Value Container::remove(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Container.remove", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
     if (info.Length() != 1) {
         PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mContainer)
     }
 
     Field field;
-    GSType type = mTypeList[0];
+    GSType type = mSchema->columnType(0);
     Napi::Value fieldValue = info[0].As<Napi::Value>();
 
     GSBool exists = GS_FALSE;
     GSResult ret;
 
     if (type == GS_TYPE_NULL) {
+        int64_t startTime = Metrics::begin();
         ret = gsDeleteRow(mContainer, NULL, &exists);
+        Metrics::record(METRIC_DELETE_ROW, mSchema->containerType(),
+                startTime, ret);
     } else {
         switch (type) {
         case GS_TYPE_STRING: {
             GSChar* rowkeyPtr = const_cast<GSChar*> (fieldValue.
                                 ToString().Utf8Value().c_str());
             const void * key = reinterpret_cast<void*>(&rowkeyPtr);
+            if (rowCacheEnabled()) {
+                mRowCache->invalidate(RowCache::makeKey(mName,
+                        fieldValue.ToString().Utf8Value()));
+            }
+            int64_t startTime = Metrics::begin();
             ret = gsDeleteRow(mContainer,
                     key, &exists);
+            Metrics::record(METRIC_DELETE_ROW, mSchema->containerType(),
+                    startTime, ret);
             break;
             }
         case GS_TYPE_INTEGER: {
             int tmpIntValue = fieldValue.ToNumber().Int32Value();
+            if (rowCacheEnabled()) {
+                mRowCache->invalidate(RowCache::makeKey(mName, tmpIntValue));
+            }
+            int64_t startTime = Metrics::begin();
             ret = gsDeleteRow(mContainer, &tmpIntValue, &exists);
+            Metrics::record(METRIC_DELETE_ROW, mSchema->containerType(),
+                    startTime, ret);
             break;
         }
         case GS_TYPE_LONG: {
             int64_t tmpLongValue = fieldValue.ToNumber().Int64Value();
+            if (rowCacheEnabled()) {
+                mRowCache->invalidate(RowCache::makeKey(mName, tmpLongValue));
+            }
+            int64_t startTime = Metrics::begin();
             ret = gsDeleteRow(mContainer, &tmpLongValue, &exists);
+            Metrics::record(METRIC_DELETE_ROW, mSchema->containerType(),
+                    startTime, ret);
             break;
         }
         case GS_TYPE_TIMESTAMP: {
@@ -639,7 +1127,14 @@ Napi::Value Container::remove(const Napi::CallbackInfo &info) {
                 PROMISE_REJECT_WITH_ERROR(deferred, e)
                 break;
             }
+            if (rowCacheEnabled()) {
+                mRowCache->invalidate(RowCache::makeKey(mName,
+                        tmpTimestampValue));
+            }
+            int64_t startTime = Metrics::begin();
             ret = gsDeleteRow(mContainer, &tmpTimestampValue, &exists);
+            Metrics::record(METRIC_DELETE_ROW, mSchema->containerType(),
+                    startTime, ret);
             break;
         }
 
@@ -663,8 +1158,25 @@ Napi::Value Container::remove(const Napi::CallbackInfo &info) {
 
 Napi::Value Container::getType(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
-    return Napi::Number::New(env, mContainerInfo->type);
+    return Napi::Number::New(env, mSchema->containerType());
 }
 
-}  // namespace griddb
+bool Container::rowCacheEnabled() const {
+    return mRowCache && mRowCache->enabled() && mSchema->rowKeyAssigned();
+}
 
+void Container::invalidateCachedRow(GSRow *row) {
+    if (!rowCacheEnabled()) {
+        return;
+    }
+    FieldValue key;
+    if (!GS_SUCCEEDED(readFieldValue(row, 0, mSchema->columnType(0), &key))) {
+        mRowCache->invalidateContainer(mName);
+    } else if (key.type == GS_TYPE_STRING) {
+        mRowCache->invalidate(RowCache::makeKey(mName, key.bytes));
+    } else {
+        mRowCache->invalidate(RowCache::makeKey(mName, key.integer));
+    }
+}
+
+}  // namespace griddb
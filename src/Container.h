@@ -20,9 +20,16 @@
 #include <napi.h>
 #include <node_buffer.h>
 #include <limits>
+#include <memory>
+#include <string>
 #include "Store.h"
 #include "Container.h"
 #include "Query.h"
+#include "ContainerSchema.h"
+#include "QueryTemplate.h"
+#include "RowCache.h"
+#include "RowPool.h"
+#include "StorePool.h"
 #include "Util.h"
 #include "Macro.h"
 
@@ -42,9 +49,13 @@ class Container: public Napi::ObjectWrap<Container> {
     // N-API methods
     Napi::Value put(const Napi::CallbackInfo &info);
     Napi::Value query(const Napi::CallbackInfo &info);
+    Napi::Value prepare(const Napi::CallbackInfo &info);
     Napi::Value get(const Napi::CallbackInfo &info);
+    Napi::Value getMany(const Napi::CallbackInfo &info);
     Napi::Value queryByTimeSeriesRange(const Napi::CallbackInfo &info);
     Napi::Value multiPut(const Napi::CallbackInfo &info);
+    Napi::Value putPacked(const Napi::CallbackInfo &info);
+    Napi::Value packedLayout(const Napi::CallbackInfo &info);
     Napi::Value createIndex(const Napi::CallbackInfo &info);
     Napi::Value dropIndex(const Napi::CallbackInfo &info);
     Napi::Value flush(const Napi::CallbackInfo &info);
@@ -53,12 +64,31 @@ class Container: public Napi::ObjectWrap<Container> {
     Napi::Value setAutoCommit(const Napi::CallbackInfo &info);
     Napi::Value remove(const Napi::CallbackInfo &info);
     Napi::Value getType(const Napi::CallbackInfo &info);
+    Napi::Value close(const Napi::CallbackInfo &info);
+
+    // Create Query object of tql, throw JS exception on error
+    Napi::Value newQuery(const Napi::Env &env, const std::string &tql);
 
  private:
-    GSContainerInfo* mContainerInfo;
     GSContainer *mContainer;
     GSRow* mRow;
-    GSType* mTypeList;
+    // Estimated bytes of mRow reported to ExternalMemory
+    int64_t mRowBytes;
+    // Rows of RowSets of the container
+    std::shared_ptr<RowPool> mRowPool;
+    std::shared_ptr<const ContainerSchema> mSchema;
+    std::string mName;
+    // Handles of the owner Store for off-thread operations
+    std::shared_ptr<StorePool> mPool;
+    QueryTemplateCache mTemplateCache;
+    // Row cache of the owner Store, may be NULL
+    std::shared_ptr<RowCache> mRowCache;
+
+    // Close container handle, can be called more than once
+    void release();
+    bool rowCacheEnabled() const;
+    // Invalidate cached row of row key of row
+    void invalidateCachedRow(GSRow *row);
 };
 
 }  // namespace griddb
@@ -16,6 +16,7 @@
 
 #include <string>
 #include "ContainerInfo.h"
+#include "ExternalMemory.h"
 
 namespace griddb {
 
@@ -58,9 +59,11 @@ Napi::Object ContainerInfo::init(const Napi::Env env, Napi::Object exports) {
 
 ContainerInfo::ContainerInfo(const Napi::CallbackInfo &info) :
         Napi::ObjectWrap<ContainerInfo>(info),
-        mContainerInfo(GS_CONTAINER_INFO_INITIALIZER), mExpInfo(NULL) {
+        mContainerInfo(GS_CONTAINER_INFO_INITIALIZER), mExpInfo(NULL),
+        mNativeSize(0) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
+    ExternalMemory::add(env, MEMORY_CONTAINER_INFO, 0);
     int length = info.Length();
     if (length == 1 && info[0].IsExternal()) {
         // Use only for method : Store.getContainerInfo()
@@ -121,6 +124,7 @@ ContainerInfo::ContainerInfo(const Napi::CallbackInfo &info) :
         mContainerInfo.triggerInfoCount = containerInfo->triggerInfoCount;
         mColumnInfoList.columnInfo = NULL;
         mColumnInfoList.size = 0;
+        updateNativeSize(env);
         return;
     } else if (length == 1  && info[0].IsObject()) {
         // Case create ContainerInfo : new griddb.ContainerInfo({..});
@@ -321,6 +325,35 @@ void ContainerInfo::init(const Napi::Env &env, const GSChar *name,
     mExpInfo = NULL;
     mColumnInfoList.columnInfo = NULL;
     mColumnInfoList.size = 0;
+    updateNativeSize(env);
+}
+
+/**
+ * @brief Report change of size of native copy of container info
+ */
+void ContainerInfo::updateNativeSize(const Napi::Env &env) {
+    int64_t size = sizeof(GSContainerInfo);
+    if (mContainerInfo.name) {
+        size += strlen(mContainerInfo.name) + 1;
+    }
+    for (size_t i = 0; i < mContainerInfo.columnCount &&
+            mContainerInfo.columnInfoList; i++) {
+        size += sizeof(GSColumnInfo);
+        if (mContainerInfo.columnInfoList[i].name) {
+            size += strlen(mContainerInfo.columnInfoList[i].name) + 1;
+        }
+    }
+    if (mContainerInfo.timeSeriesProperties) {
+        size += sizeof(GSTimeSeriesProperties);
+    }
+    if (mContainerInfo.dataAffinity) {
+        size += strlen(mContainerInfo.dataAffinity) + 1;
+    }
+    if (mContainerInfo.triggerInfoList) {
+        size += sizeof(GSTriggerInfo);
+    }
+    ExternalMemory::resize(env, MEMORY_CONTAINER_INFO, size - mNativeSize);
+    mNativeSize = size;
 }
 
 void ContainerInfo::freeMemoryPropsList(GSColumnInfo *props,
@@ -370,6 +403,7 @@ ContainerInfo::~ContainerInfo() {
     if (mExpInfo != NULL) {
         delete mExpInfo;
     }
+    ExternalMemory::remove(Env(), MEMORY_CONTAINER_INFO, mNativeSize);
 }
 
 Napi::Value ContainerInfo::getName(const Napi::CallbackInfo &info) {
@@ -391,6 +425,7 @@ void ContainerInfo::setName(const Napi::CallbackInfo &info,
     }
 
     mContainerInfo.name = Util::strdup(containerName.c_str());
+    updateNativeSize(env);
 }
 
 Napi::Value ContainerInfo::getType(const Napi::CallbackInfo &info) {
@@ -526,6 +561,7 @@ void ContainerInfo::setColumnInfoList(const Napi::CallbackInfo &info,
     mContainerInfo.columnInfoList = NULL;
 
     if (columnInfoList.size == 0 || columnInfoList.columnInfo == NULL) {
+        updateNativeSize(env);
         return;
     }
 
@@ -559,6 +595,7 @@ void ContainerInfo::setColumnInfoList(const Napi::CallbackInfo &info,
     mContainerInfo.columnInfoList = tmpColumnInfoList;
 
     this->freeColumnInfoList(&columnInfoList);
+    updateNativeSize(env);
 }
 
 Napi::Value ContainerInfo::getColumnInfoList(
@@ -71,6 +71,9 @@ class ContainerInfo: public Napi::ObjectWrap<ContainerInfo> {
 
     // Tmp attribute support get expiration attribute
     ExpirationInfo* mExpInfo;
+    // Bytes reported to ExternalMemory
+    int64_t mNativeSize;
+    void updateNativeSize(const Napi::Env &env);
     void freeMemoryPropsList(GSColumnInfo *props, int propsCount);
     void freeColumnInfoList(ColumnInfoList* columnInfoList);
     void init(const Napi::Env &env, const GSChar* name, GSContainerType type,
@@ -0,0 +1,443 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#include "ContainerSchema.h"
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include "ExternalMemory.h"
+#include "Macro.h"
+
+namespace griddb {
+
+// Interned schemas by hash. Entries are removed when the schema is
+// released, so the registry only holds schemas still in use
+typedef std::unordered_multimap<size_t,
+        std::pair<ContainerSchema*, std::weak_ptr<ContainerSchema> > >
+        SchemaRegistry;
+
+static std::mutex sRegistryMutex;
+
+static SchemaRegistry& getRegistry() {
+    // Never destroyed: schemas may be released on addon unloading
+    static SchemaRegistry *registry = new SchemaRegistry();
+    return *registry;
+}
+
+static bool equalString(const GSChar *a, const GSChar *b) {
+    if (a == NULL || b == NULL) {
+        return a == b;
+    }
+    return strcmp(a, b) == 0;
+}
+
+// Column names are case insensitive
+static std::string toLowerName(std::string name) {
+    std::transform(name.begin(), name.end(), name.begin(),
+            [](unsigned char c) { return std::tolower(c); });
+    return name;
+}
+
+// Estimated bytes of a GSRow besides its fields
+#define ROW_OVERHEAD_SIZE 64
+// Estimated bytes of a field of variable size type
+#define VARIABLE_FIELD_SIZE 32
+
+static int64_t estimatedFieldSize(GSType type) {
+    switch (type) {
+    case GS_TYPE_BOOL:
+    case GS_TYPE_BYTE:
+        return 1;
+    case GS_TYPE_SHORT:
+        return 2;
+    case GS_TYPE_INTEGER:
+    case GS_TYPE_FLOAT:
+        return 4;
+    case GS_TYPE_LONG:
+    case GS_TYPE_DOUBLE:
+    case GS_TYPE_TIMESTAMP:
+        return 8;
+    default:
+        return VARIABLE_FIELD_SIZE;
+    }
+}
+
+static void hashCombine(size_t *seed, size_t value) {
+    *seed ^= value + 0x9e3779b9 + (*seed << 6) + (*seed >> 2);
+}
+
+ContainerSchema::ContainerSchema() :
+        mContainerInfo(GS_CONTAINER_INFO_INITIALIZER), mHash(0),
+        mRowSize(ROW_OVERHEAD_SIZE), mNativeSize(0) {
+}
+
+ContainerSchema::~ContainerSchema() {
+    ExternalMemory::remove(mMemoryAccount.get(), MEMORY_SCHEMA, mNativeSize);
+}
+
+/**
+ * @brief Deep copy schema part of containerInfo.
+ * @param *containerInfo Source container information
+ * @return New schema, owned by caller
+ */
+ContainerSchema* ContainerSchema::copy(const GSContainerInfo *containerInfo,
+        const std::shared_ptr<MemoryAccount> &account) {
+    std::unique_ptr<ContainerSchema> schema(new ContainerSchema());
+    GSContainerInfo &info = schema->mContainerInfo;
+    info.type = containerInfo->type;
+    info.rowKeyAssigned = containerInfo->rowKeyAssigned;
+    info.columnOrderIgnorable = containerInfo->columnOrderIgnorable;
+    info.columnCount = containerInfo->columnCount;
+
+    size_t columnCount = containerInfo->columnCount;
+    schema->mColumnNameList.resize(columnCount);
+    schema->mColumnInfoList.resize(columnCount);
+    schema->mTypeList.resize(columnCount);
+    schema->mFromFieldList.resize(columnCount);
+    schema->mToFieldList.resize(columnCount);
+    for (size_t i = 0; i < columnCount; i++) {
+        const GSColumnInfo &from = containerInfo->columnInfoList[i];
+        GSColumnInfo &to = schema->mColumnInfoList[i];
+        to = from;
+        if (from.name) {
+            schema->mColumnNameList[i] = from.name;
+        }
+        // Converters are looked up once here instead of for each field
+        schema->mTypeList[i] = from.type;
+        schema->mFromFieldList[i] = Util::fromFieldFunc(from.type);
+        schema->mToFieldList[i] = Util::toFieldFunc(from.type);
+    }
+    // Point to own strings once vectors are not resized any more
+    for (size_t i = 0; i < columnCount; i++) {
+        if (containerInfo->columnInfoList[i].name) {
+            schema->mColumnInfoList[i].name =
+                    schema->mColumnNameList[i].c_str();
+            schema->mColumnIndexMap.emplace(
+                    toLowerName(schema->mColumnNameList[i]),
+                    static_cast<int>(i));
+        }
+    }
+    info.columnInfoList = schema->mColumnInfoList.data();
+
+    if (containerInfo->timeSeriesProperties) {
+        schema->mTimeSeriesProperties = *containerInfo->timeSeriesProperties;
+        const GSTimeSeriesProperties &props =
+                *containerInfo->timeSeriesProperties;
+        if (props.compressionList && props.compressionListSize > 0) {
+            schema->mCompressionList.assign(props.compressionList,
+                    props.compressionList + props.compressionListSize);
+            schema->mCompressionNameList.resize(props.compressionListSize);
+            for (size_t i = 0; i < props.compressionListSize; i++) {
+                if (props.compressionList[i].columnName) {
+                    schema->mCompressionNameList[i] =
+                            props.compressionList[i].columnName;
+                    schema->mCompressionList[i].columnName =
+                            schema->mCompressionNameList[i].c_str();
+                }
+            }
+            schema->mTimeSeriesProperties.compressionList =
+                    schema->mCompressionList.data();
+        } else {
+            schema->mTimeSeriesProperties.compressionList = NULL;
+            schema->mTimeSeriesProperties.compressionListSize = 0;
+        }
+        info.timeSeriesProperties = &schema->mTimeSeriesProperties;
+    }
+    if (containerInfo->dataAffinity) {
+        schema->mDataAffinity = containerInfo->dataAffinity;
+        info.dataAffinity = schema->mDataAffinity.c_str();
+    }
+
+    int64_t nativeSize = sizeof(ContainerSchema);
+    for (size_t i = 0; i < columnCount; i++) {
+        schema->mRowSize += estimatedFieldSize(schema->mTypeList[i]);
+        // Column info, name, lower case name in index and converters
+        nativeSize += sizeof(GSColumnInfo) + sizeof(GSType) +
+                sizeof(Util::FromFieldFunc) + sizeof(Util::ToFieldFunc) +
+                2 * schema->mColumnNameList[i].capacity() +
+                sizeof(std::pair<std::string, int>);
+    }
+    schema->mNativeSize = nativeSize;
+    schema->mMemoryAccount = account;
+    ExternalMemory::add(account.get(), MEMORY_SCHEMA, nativeSize);
+    return schema.release();
+}
+
+/**
+ * @brief Create schema which is not shared with other containers.
+ * @param *containerInfo Source container information
+ * @return New immutable schema
+ */
+std::shared_ptr<const ContainerSchema> ContainerSchema::create(
+        const GSContainerInfo *containerInfo,
+        const std::shared_ptr<MemoryAccount> &account) {
+    return std::shared_ptr<ContainerSchema>(copy(containerInfo, account));
+}
+
+/**
+ * @brief Get shared schema equal to schema part of containerInfo. A new
+ *   schema is created only if no schema in use is equal.
+ *   Schemas with column compression settings are not shared.
+ * @param *containerInfo Source container information
+ * @return Shared immutable schema
+ */
+std::shared_ptr<const ContainerSchema> ContainerSchema::intern(
+        const GSContainerInfo *containerInfo,
+        const std::shared_ptr<MemoryAccount> &account) {
+    if (containerInfo->timeSeriesProperties &&
+            containerInfo->timeSeriesProperties->compressionListSize > 0) {
+        return create(containerInfo, account);
+    }
+    size_t key = hash(containerInfo);
+    // Locked candidates may be the last owners when other threads drop
+    // theirs. Keep them until the mutex is unlocked, the deleter release()
+    // locks it again and erases from the registry
+    std::vector<std::shared_ptr<ContainerSchema> > candidateList;
+    std::lock_guard<std::mutex> guard(sRegistryMutex);
+    SchemaRegistry &registry = getRegistry();
+    auto range = registry.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        std::shared_ptr<ContainerSchema> schema = it->second.second.lock();
+        if (!schema) {
+            continue;
+        }
+        candidateList.push_back(schema);
+        if (schema->matches(containerInfo)) {
+            return schema;
+        }
+    }
+    std::shared_ptr<ContainerSchema> schema(copy(containerInfo, account),
+            ContainerSchema::release);
+    schema->mHash = key;
+    registry.insert(std::make_pair(key, std::make_pair(schema.get(),
+            std::weak_ptr<ContainerSchema>(schema))));
+    return schema;
+}
+
+/**
+ * @brief Deleter of interned schema: remove it from registry.
+ */
+void ContainerSchema::release(ContainerSchema *schema) {
+    {
+        std::lock_guard<std::mutex> guard(sRegistryMutex);
+        SchemaRegistry &registry = getRegistry();
+        auto range = registry.equal_range(schema->mHash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second.first == schema) {
+                registry.erase(it);
+                break;
+            }
+        }
+    }
+    delete schema;
+}
+
+size_t ContainerSchema::hash(const GSContainerInfo *containerInfo) {
+    std::hash<std::string> stringHash;
+    size_t seed = containerInfo->columnCount;
+    hashCombine(&seed, static_cast<size_t>(containerInfo->type));
+    hashCombine(&seed, static_cast<size_t>(containerInfo->rowKeyAssigned));
+    for (size_t i = 0; i < containerInfo->columnCount; i++) {
+        const GSColumnInfo &column = containerInfo->columnInfoList[i];
+        hashCombine(&seed, column.name ? stringHash(column.name) : 0);
+        hashCombine(&seed, static_cast<size_t>(column.type));
+        hashCombine(&seed, static_cast<size_t>(column.indexTypeFlags));
+        hashCombine(&seed, static_cast<size_t>(column.options));
+    }
+    return seed;
+}
+
+bool ContainerSchema::matches(const GSContainerInfo *containerInfo) const {
+    const GSContainerInfo &info = mContainerInfo;
+    if (info.type != containerInfo->type ||
+            info.rowKeyAssigned != containerInfo->rowKeyAssigned ||
+            info.columnOrderIgnorable !=
+                    containerInfo->columnOrderIgnorable ||
+            info.columnCount != containerInfo->columnCount ||
+            !equalString(info.dataAffinity, containerInfo->dataAffinity)) {
+        return false;
+    }
+    for (size_t i = 0; i < info.columnCount; i++) {
+        const GSColumnInfo &a = info.columnInfoList[i];
+        const GSColumnInfo &b = containerInfo->columnInfoList[i];
+        if (a.type != b.type || a.indexTypeFlags != b.indexTypeFlags ||
+                a.options != b.options || !equalString(a.name, b.name)) {
+            return false;
+        }
+    }
+    const GSTimeSeriesProperties *a = info.timeSeriesProperties;
+    const GSTimeSeriesProperties *b = containerInfo->timeSeriesProperties;
+    if (a == NULL || b == NULL) {
+        return a == b;
+    }
+    return a->rowExpirationTime == b->rowExpirationTime &&
+            a->rowExpirationTimeUnit == b->rowExpirationTimeUnit &&
+            a->compressionWindowSize == b->compressionWindowSize &&
+            a->compressionWindowSizeUnit == b->compressionWindowSizeUnit &&
+#if !(GS_COMPATIBILITY_TIME_SERIES_PROPERTIES_0_0_10)
+            a->compressionMethod == b->compressionMethod &&
+#endif
+#if GS_COMPATIBILITY_SUPPORT_2_0
+            a->expirationDivisionCount == b->expirationDivisionCount &&
+#endif
+            a->compressionListSize == b->compressionListSize;
+}
+
+/**
+ * @brief Fill containerInfo with this schema and name. containerInfo
+ *   refers to memory of this schema, so it is valid while schema is.
+ */
+void ContainerSchema::toContainerInfo(const GSChar *name,
+        GSContainerInfo *containerInfo) const {
+    *containerInfo = mContainerInfo;
+    containerInfo->name = name;
+}
+
+size_t ContainerSchema::columnCount() const {
+    return mContainerInfo.columnCount;
+}
+
+GSContainerType ContainerSchema::containerType() const {
+    return mContainerInfo.type;
+}
+
+bool ContainerSchema::rowKeyAssigned() const {
+    return mContainerInfo.rowKeyAssigned == GS_TRUE;
+}
+
+GSType ContainerSchema::columnType(size_t column) const {
+    return mTypeList[column];
+}
+
+const GSChar* ContainerSchema::columnName(size_t column) const {
+    return mColumnInfoList[column].name;
+}
+
+int ContainerSchema::columnIndex(const std::string &name) const {
+    auto it = mColumnIndexMap.find(toLowerName(name));
+    return it == mColumnIndexMap.end() ? -1 : it->second;
+}
+
+const GSType* ContainerSchema::typeList() const {
+    return mTypeList.data();
+}
+
+int64_t ContainerSchema::estimatedRowSize() const {
+    return mRowSize;
+}
+
+Napi::Value ContainerSchema::fromField(const Napi::Env &env, GSRow *row,
+        int column) const {
+    return mFromFieldList[column](env, row, column);
+}
+
+/**
+ * @brief Convert all fields of row to array
+ * @param env Napi env
+ * @param *row Row of container with this schema
+ * @return Array of field values
+ */
+Napi::Value ContainerSchema::fromRow(const Napi::Env &env,
+        GSRow *row) const {
+    size_t columnCount = mFromFieldList.size();
+    Napi::Array output = Napi::Array::New(env, columnCount);
+    for (size_t i = 0; i < columnCount; i++) {
+        output.Set(static_cast<uint32_t>(i),
+                mFromFieldList[i](env, row, static_cast<int>(i)));
+    }
+    return output;
+}
+
+/**
+ * @brief Convert projected fields of row to array
+ * @param env Napi env
+ * @param *row Row of container with this schema
+ * @param projection Column numbers made by toProjection()
+ * @return Array of field values in order of projection
+ */
+Napi::Value ContainerSchema::fromRow(const Napi::Env &env, GSRow *row,
+        const std::vector<int> &projection) const {
+    Napi::Array output = Napi::Array::New(env, projection.size());
+    for (size_t i = 0; i < projection.size(); i++) {
+        int column = projection[i];
+        output.Set(static_cast<uint32_t>(i),
+                mFromFieldList[column](env, row, column));
+    }
+    return output;
+}
+
+/**
+ * @brief Resolve columns option once, so that only these columns are
+ *   converted for each row
+ * @param env Napi env
+ * @param columns Array of column names or column numbers
+ * @param *projection Output column numbers
+ */
+void ContainerSchema::toProjection(const Napi::Env &env,
+        const Napi::Value &columns, std::vector<int> *projection) const {
+    if (!columns.IsArray()) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "columns should be array")
+    }
+    Napi::Array columnArray = columns.As<Napi::Array>();
+    projection->clear();
+    projection->reserve(columnArray.Length());
+    for (uint32_t i = 0; i < columnArray.Length(); i++) {
+        Napi::Value column = columnArray[i];
+        int columnIndex = -1;
+        if (column.IsNumber()) {
+            int64_t number = column.As<Napi::Number>().Int64Value();
+            if (number >= 0 &&
+                    number < static_cast<int64_t>(mTypeList.size())) {
+                columnIndex = static_cast<int>(number);
+            }
+        } else if (column.IsString()) {
+            columnIndex = this->columnIndex(
+                    column.As<Napi::String>().Utf8Value());
+        }
+        if (columnIndex < 0) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "Column not found")
+        }
+        projection->push_back(columnIndex);
+    }
+}
+
+bool ContainerSchema::toProjectionOption(const Napi::Env &env,
+        const Napi::Value &options, std::vector<int> *projection) const {
+    if (!options.IsObject()) {
+        return false;
+    }
+    Napi::Object obj = options.As<Napi::Object>();
+    if (!obj.Has("columns") || obj.Get("columns").IsUndefined()) {
+        return false;
+    }
+    toProjection(env, obj.Get("columns"), projection);
+    return true;
+}
+
+void ContainerSchema::toField(const Napi::Env &env, Napi::Value *value,
+        GSRow *row, int column) const {
+    if (value->IsNull() || value->IsUndefined()) {
+        Util::toFieldAsNull(env, value, row, column);
+        return;
+    }
+    mToFieldList[column](env, value, row, column);
+}
+
+}  // namespace griddb
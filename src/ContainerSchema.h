@@ -0,0 +1,107 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef CONTAINERSCHEMA_H
+#define CONTAINERSCHEMA_H
+
+#include <napi.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ExternalMemory.h"
+#include "Util.h"
+#include "gridstore.h"
+
+namespace griddb {
+
+// Immutable copy of a container schema: everything in GSContainerInfo
+// except the container name. Containers with the same schema share one
+// instance, see intern(). Trigger and index info lists are not kept.
+class ContainerSchema :
+        public std::enable_shared_from_this<ContainerSchema> {
+ public:
+    ~ContainerSchema();
+
+    // Memory of a new schema is charged to account
+    static std::shared_ptr<const ContainerSchema> create(
+            const GSContainerInfo *containerInfo,
+            const std::shared_ptr<MemoryAccount> &account);
+    static std::shared_ptr<const ContainerSchema> intern(
+            const GSContainerInfo *containerInfo,
+            const std::shared_ptr<MemoryAccount> &account);
+
+    void toContainerInfo(const GSChar *name,
+            GSContainerInfo *containerInfo) const;
+    size_t columnCount() const;
+    GSContainerType containerType() const;
+    bool rowKeyAssigned() const;
+    GSType columnType(size_t column) const;
+    const GSChar* columnName(size_t column) const;
+    // Column number of case insensitive name, -1 if not found
+    int columnIndex(const std::string &name) const;
+    const GSType* typeList() const;
+    // Estimated bytes of one GSRow of this schema held by the C client
+    int64_t estimatedRowSize() const;
+
+    // Convert between GSRow and Napi::Value with converters of this schema
+    Napi::Value fromField(const Napi::Env &env, GSRow *row,
+            int column) const;
+    Napi::Value fromRow(const Napi::Env &env, GSRow *row) const;
+    Napi::Value fromRow(const Napi::Env &env, GSRow *row,
+            const std::vector<int> &projection) const;
+    void toField(const Napi::Env &env, Napi::Value *value, GSRow *row,
+            int column) const;
+
+    // Column numbers from array of column names or numbers.
+    // Throw Napi::Error for unknown column
+    void toProjection(const Napi::Env &env, const Napi::Value &columns,
+            std::vector<int> *projection) const;
+    // Same for "columns" of options object. Return false if not specified
+    bool toProjectionOption(const Napi::Env &env, const Napi::Value &options,
+            std::vector<int> *projection) const;
+
+ private:
+    GSContainerInfo mContainerInfo;
+    std::vector<GSColumnInfo> mColumnInfoList;
+    std::vector<std::string> mColumnNameList;
+    GSTimeSeriesProperties mTimeSeriesProperties;
+    std::vector<GSColumnCompression> mCompressionList;
+    std::vector<std::string> mCompressionNameList;
+    std::string mDataAffinity;
+    std::vector<GSType> mTypeList;
+    std::vector<Util::FromFieldFunc> mFromFieldList;
+    std::vector<Util::ToFieldFunc> mToFieldList;
+    // Column number by lower case column name
+    std::unordered_map<std::string, int> mColumnIndexMap;
+    size_t mHash;
+    int64_t mRowSize;
+    // Bytes reported to ExternalMemory
+    int64_t mNativeSize;
+    // Schemas may be freed on any thread, see ExternalMemory
+    std::shared_ptr<MemoryAccount> mMemoryAccount;
+
+    ContainerSchema();
+    static ContainerSchema* copy(const GSContainerInfo *containerInfo,
+            const std::shared_ptr<MemoryAccount> &account);
+    static size_t hash(const GSContainerInfo *containerInfo);
+    static void release(ContainerSchema *schema);
+    bool matches(const GSContainerInfo *containerInfo) const;
+};
+
+}  // namespace griddb
+
+#endif  // CONTAINERSCHEMA_H
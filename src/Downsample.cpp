@@ -0,0 +1,148 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Downsample.h"
+#include <cmath>
+
+namespace griddb {
+
+// First point of bucket, bucket == buckets gives the end
+static size_t bucketStart(size_t bucket, size_t buckets, size_t count) {
+    return static_cast<size_t>(
+            static_cast<double>(bucket) * count / buckets);
+}
+
+void downsampleLttb(const PointSeries &input, size_t buckets,
+        PointSeries *output) {
+    size_t count = input.size();
+    if (buckets >= count) {
+        *output = input;
+        return;
+    }
+    output->time.reserve(buckets);
+    output->value.reserve(buckets);
+    if (buckets == 0) {
+        return;
+    }
+    output->add(input.time[0], input.value[0]);
+    if (buckets < 3) {
+        // No inner bucket, only the first and the last point
+        if (buckets == 2) {
+            output->add(input.time[count - 1], input.value[count - 1]);
+        }
+        return;
+    }
+
+    // Inner points are split into buckets - 2 buckets
+    size_t innerCount = count - 2;
+    size_t innerBuckets = buckets - 2;
+    size_t selected = 0;
+    for (size_t i = 0; i < innerBuckets; i++) {
+        size_t start = 1 + bucketStart(i, innerBuckets, innerCount);
+        size_t end = 1 + bucketStart(i + 1, innerBuckets, innerCount);
+        // Average of next bucket, the last point for the last bucket
+        size_t nextStart = end;
+        size_t nextEnd = i + 1 < innerBuckets ?
+                1 + bucketStart(i + 2, innerBuckets, innerCount) : count;
+        double avgTime = 0;
+        double avgValue = 0;
+        for (size_t j = nextStart; j < nextEnd; j++) {
+            avgTime += input.time[j];
+            avgValue += input.value[j];
+        }
+        avgTime /= static_cast<double>(nextEnd - nextStart);
+        avgValue /= static_cast<double>(nextEnd - nextStart);
+
+        double baseTime = input.time[selected];
+        double baseValue = input.value[selected];
+        double maxArea = -1;
+        size_t maxIndex = start;
+        for (size_t j = start; j < end; j++) {
+            double area = std::fabs(
+                    (baseTime - avgTime) * (input.value[j] - baseValue) -
+                    (baseTime - input.time[j]) * (avgValue - baseValue));
+            if (area > maxArea) {
+                maxArea = area;
+                maxIndex = j;
+            }
+        }
+        output->add(input.time[maxIndex], input.value[maxIndex]);
+        selected = maxIndex;
+    }
+    output->add(input.time[count - 1], input.value[count - 1]);
+}
+
+void downsampleMinMax(const PointSeries &input, size_t buckets,
+        PointSeries *output) {
+    size_t count = input.size();
+    if (buckets * 2 >= count || buckets == 0) {
+        *output = input;
+        return;
+    }
+    output->time.reserve(buckets * 2);
+    output->value.reserve(buckets * 2);
+    for (size_t i = 0; i < buckets; i++) {
+        size_t start = bucketStart(i, buckets, count);
+        size_t end = bucketStart(i + 1, buckets, count);
+        if (start == end) {
+            continue;
+        }
+        size_t minIndex = start;
+        size_t maxIndex = start;
+        for (size_t j = start + 1; j < end; j++) {
+            if (input.value[j] < input.value[minIndex]) {
+                minIndex = j;
+            }
+            if (input.value[j] > input.value[maxIndex]) {
+                maxIndex = j;
+            }
+        }
+        size_t first = minIndex < maxIndex ? minIndex : maxIndex;
+        size_t second = minIndex < maxIndex ? maxIndex : minIndex;
+        output->add(input.time[first], input.value[first]);
+        if (second != first) {
+            output->add(input.time[second], input.value[second]);
+        }
+    }
+}
+
+void downsampleAverage(const PointSeries &input, size_t buckets,
+        PointSeries *output) {
+    size_t count = input.size();
+    if (buckets >= count || buckets == 0) {
+        *output = input;
+        return;
+    }
+    output->time.reserve(buckets);
+    output->value.reserve(buckets);
+    for (size_t i = 0; i < buckets; i++) {
+        size_t start = bucketStart(i, buckets, count);
+        size_t end = bucketStart(i + 1, buckets, count);
+        if (start == end) {
+            continue;
+        }
+        double sumTime = 0;
+        double sumValue = 0;
+        for (size_t j = start; j < end; j++) {
+            sumTime += input.time[j];
+            sumValue += input.value[j];
+        }
+        double n = static_cast<double>(end - start);
+        output->add(sumTime / n, sumValue / n);
+    }
+}
+
+}  // namespace griddb
@@ -0,0 +1,56 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef DOWNSAMPLE_H
+#define DOWNSAMPLE_H
+
+#include <stddef.h>
+#include <vector>
+
+namespace griddb {
+
+// Series of points in time order
+struct PointSeries {
+    std::vector<double> time;
+    std::vector<double> value;
+
+    size_t size() const {
+        return time.size();
+    }
+    void add(double t, double v) {
+        time.push_back(t);
+        value.push_back(v);
+    }
+};
+
+// Downsampling kernels for charting. Points are split into buckets of
+// equal point count. Series shorter than output are copied as is
+
+// Largest-Triangle-Three-Buckets: buckets points, keeping the first and
+// the last point. 1 bucket gives only the first point
+void downsampleLttb(const PointSeries &input, size_t buckets,
+        PointSeries *output);
+// Minimum and maximum points of each bucket in time order, up to
+// 2 * buckets points
+void downsampleMinMax(const PointSeries &input, size_t buckets,
+        PointSeries *output);
+// Mean time and mean value of each bucket
+void downsampleAverage(const PointSeries &input, size_t buckets,
+        PointSeries *output);
+
+}  // namespace griddb
+
+#endif  // DOWNSAMPLE_H
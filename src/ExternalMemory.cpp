@@ -0,0 +1,128 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "ExternalMemory.h"
+
+namespace griddb {
+
+static const char* const MEMORY_TYPE_NAMES[] = {
+    "rowSet", "row", "blob", "containerInfo", "schema", "rowCache"
+};
+
+std::atomic<int64_t> ExternalMemory::sCountList[MEMORY_TYPE_COUNT];
+std::atomic<int64_t> ExternalMemory::sBytesList[MEMORY_TYPE_COUNT];
+std::atomic<int64_t> ExternalMemory::sTotal(0);
+std::mutex ExternalMemory::sAccountMutex;
+std::map<napi_env, std::shared_ptr<MemoryAccount> >
+        ExternalMemory::sAccountMap;
+
+MemoryAccount::MemoryAccount() : mPending(0) {
+}
+
+void ExternalMemory::init(Napi::Env env, Napi::Object exports) {
+    {
+        std::lock_guard<std::mutex> guard(sAccountMutex);
+        sAccountMap[env] = std::make_shared<MemoryAccount>();
+    }
+    // Objects still holding the account may update it after this,
+    // their changes are no longer reported
+    napi_add_env_cleanup_hook(env, &ExternalMemory::removeAccount, env);
+    exports.Set("memoryStats", Napi::Function::New(env,
+            &ExternalMemory::stats, "memoryStats"));
+}
+
+void ExternalMemory::removeAccount(void *env) {
+    std::lock_guard<std::mutex> guard(sAccountMutex);
+    sAccountMap.erase(static_cast<napi_env>(env));
+}
+
+std::shared_ptr<MemoryAccount> ExternalMemory::account(Napi::Env env) {
+    std::lock_guard<std::mutex> guard(sAccountMutex);
+    std::map<napi_env, std::shared_ptr<MemoryAccount> >::iterator it =
+            sAccountMap.find(env);
+    if (it == sAccountMap.end()) {
+        // Env is being torn down, nothing is reported to it any more
+        return std::make_shared<MemoryAccount>();
+    }
+    return it->second;
+}
+
+void ExternalMemory::add(MemoryAccount *account, MemoryType type,
+        int64_t bytes) {
+    sCountList[type].fetch_add(1, std::memory_order_relaxed);
+    resize(account, type, bytes);
+}
+
+void ExternalMemory::remove(MemoryAccount *account, MemoryType type,
+        int64_t bytes) {
+    sCountList[type].fetch_sub(1, std::memory_order_relaxed);
+    resize(account, type, -bytes);
+}
+
+void ExternalMemory::resize(MemoryAccount *account, MemoryType type,
+        int64_t delta) {
+    sBytesList[type].fetch_add(delta, std::memory_order_relaxed);
+    sTotal.fetch_add(delta, std::memory_order_relaxed);
+    account->mPending.fetch_add(delta, std::memory_order_relaxed);
+}
+
+void ExternalMemory::add(Napi::Env env, MemoryType type, int64_t bytes) {
+    add(account(env).get(), type, bytes);
+    sync(env);
+}
+
+void ExternalMemory::remove(Napi::Env env, MemoryType type, int64_t bytes) {
+    remove(account(env).get(), type, bytes);
+    sync(env);
+}
+
+void ExternalMemory::resize(Napi::Env env, MemoryType type, int64_t delta) {
+    resize(account(env).get(), type, delta);
+    sync(env);
+}
+
+void ExternalMemory::sync(Napi::Env env) {
+    std::shared_ptr<MemoryAccount> target = account(env);
+    int64_t delta = target->mPending.exchange(0, std::memory_order_relaxed);
+    if (delta != 0) {
+        Napi::MemoryManagement::AdjustExternalMemory(env, delta);
+    }
+}
+
+/**
+ * @brief Native memory held by binding objects
+ * @return {type: {count, bytes}, total}. Types are rowSet, row, blob,
+ *   containerInfo, schema and rowCache. count of rowCache is the number
+ *   of cached rows
+ */
+Napi::Value ExternalMemory::stats(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    sync(env);
+    Napi::Object result = Napi::Object::New(env);
+    for (int i = 0; i < MEMORY_TYPE_COUNT; i++) {
+        Napi::Object stats = Napi::Object::New(env);
+        stats.Set("count", Napi::Number::New(env, static_cast<double>(
+                sCountList[i].load(std::memory_order_relaxed))));
+        stats.Set("bytes", Napi::Number::New(env, static_cast<double>(
+                sBytesList[i].load(std::memory_order_relaxed))));
+        result.Set(MEMORY_TYPE_NAMES[i], stats);
+    }
+    result.Set("total", Napi::Number::New(env, static_cast<double>(
+            sTotal.load(std::memory_order_relaxed))));
+    return result;
+}
+
+}  // namespace griddb
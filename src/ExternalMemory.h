@@ -0,0 +1,98 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef EXTERNALMEMORY_H
+#define EXTERNALMEMORY_H
+
+#include <napi.h>
+#include <stdint.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace griddb {
+
+// Native allocations reported to V8
+enum MemoryType {
+    MEMORY_ROW_SET,
+    MEMORY_ROW,
+    MEMORY_BLOB,
+    MEMORY_CONTAINER_INFO,
+    MEMORY_SCHEMA,
+    MEMORY_ROW_CACHE,
+    MEMORY_TYPE_COUNT
+};
+
+// Native memory charged to the V8 isolate of one env. Changes can be made
+// on any thread, they are queued until sync() on the JS thread of the env.
+// Objects which may be changed or freed off their JS thread keep the
+// account of the env that created them
+class MemoryAccount {
+ public:
+    MemoryAccount();
+
+ private:
+    friend class ExternalMemory;
+    std::atomic<int64_t> mPending;
+};
+
+// Process wide accounting of native memory held by binding objects.
+// Counters can be updated from any thread. Each change is also charged to
+// the account of one env and reported to its isolate with
+// napi_adjust_external_memory by sync(), so that GC runs when wrappers
+// hold much native memory. Each worker_thread has its own env, so memory
+// is never reported to another isolate than the one that was charged.
+// Sizes of memory owned by the C client are estimates
+class ExternalMemory {
+ public:
+    static void init(Napi::Env env, Napi::Object exports);
+
+    // Account of env, for objects changed or freed on other threads
+    static std::shared_ptr<MemoryAccount> account(Napi::Env env);
+
+    // Object of type with bytes is allocated or freed, any thread
+    static void add(MemoryAccount *account, MemoryType type, int64_t bytes);
+    static void remove(MemoryAccount *account, MemoryType type,
+            int64_t bytes);
+    // Size of an existing object changed, any thread
+    static void resize(MemoryAccount *account, MemoryType type,
+            int64_t delta);
+    // Same as above on the JS thread of env, charged to env and sync()
+    static void add(Napi::Env env, MemoryType type, int64_t bytes);
+    static void remove(Napi::Env env, MemoryType type, int64_t bytes);
+    static void resize(Napi::Env env, MemoryType type, int64_t delta);
+
+    // Report changes queued to the account of env to V8
+    static void sync(Napi::Env env);
+
+    // griddb.memoryStats(): live objects and bytes by type
+    static Napi::Value stats(const Napi::CallbackInfo &info);
+
+ private:
+    static std::atomic<int64_t> sCountList[MEMORY_TYPE_COUNT];
+    static std::atomic<int64_t> sBytesList[MEMORY_TYPE_COUNT];
+    static std::atomic<int64_t> sTotal;
+    // Accounts of live envs
+    static std::mutex sAccountMutex;
+    static std::map<napi_env, std::shared_ptr<MemoryAccount> > sAccountMap;
+
+    static void removeAccount(void *env);
+};
+
+}  // namespace griddb
+
+#endif  // EXTERNALMEMORY_H
@@ -0,0 +1,323 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "FieldValue.h"
+#include <cmath>
+#include <limits>
+#include "Metrics.h"
+#include "Util.h"
+#include "Macro.h"
+
+namespace griddb {
+
+static bool isNullField(GSRow *row, int column) {
+    GSBool nullValue;
+    GSResult ret = gsGetRowFieldNull(row, column, &nullValue);
+    return GS_SUCCEEDED(ret) && nullValue == GS_TRUE;
+}
+
+/**
+ * @brief Copy field of row. NULL is detected like Util::fromField
+ */
+GSResult readFieldValue(GSRow *row, int column, GSType type,
+        FieldValue *value) {
+    GSResult ret;
+    value->type = type;
+    value->isNull = false;
+    value->integer = 0;
+    value->number = 0;
+    value->bytes.clear();
+    switch (type) {
+    case GS_TYPE_STRING:
+    case GS_TYPE_GEOMETRY: {
+        const GSChar *str;
+        ret = type == GS_TYPE_STRING ?
+                gsGetRowFieldAsString(row, column, &str) :
+                gsGetRowFieldAsGeometry(row, column, &str);
+        if (GS_SUCCEEDED(ret) && str) {
+            value->bytes.assign(str);
+        }
+        break;
+    }
+    case GS_TYPE_BLOB: {
+        GSBlob blob;
+        ret = gsGetRowFieldAsBlob(row, column, &blob);
+        if (GS_SUCCEEDED(ret) && blob.size) {
+            value->bytes.assign(static_cast<const char*>(blob.data),
+                    blob.size);
+        }
+        break;
+    }
+    case GS_TYPE_BOOL: {
+        GSBool boolValue;
+        ret = gsGetRowFieldAsBool(row, column, &boolValue);
+        value->integer = boolValue ? 1 : 0;
+        break;
+    }
+    case GS_TYPE_BYTE: {
+        int8_t byteValue;
+        ret = gsGetRowFieldAsByte(row, column, &byteValue);
+        value->integer = byteValue;
+        break;
+    }
+    case GS_TYPE_SHORT: {
+        int16_t shortValue;
+        ret = gsGetRowFieldAsShort(row, column, &shortValue);
+        value->integer = shortValue;
+        break;
+    }
+    case GS_TYPE_INTEGER: {
+        int32_t intValue;
+        ret = gsGetRowFieldAsInteger(row, column, &intValue);
+        value->integer = intValue;
+        break;
+    }
+    case GS_TYPE_LONG:
+        ret = gsGetRowFieldAsLong(row, column, &value->integer);
+        break;
+    case GS_TYPE_TIMESTAMP:
+        ret = gsGetRowFieldAsTimestamp(row, column, &value->integer);
+        break;
+    case GS_TYPE_FLOAT: {
+        float floatValue;
+        ret = gsGetRowFieldAsFloat(row, column, &floatValue);
+        value->number = floatValue;
+        break;
+    }
+    case GS_TYPE_DOUBLE:
+        ret = gsGetRowFieldAsDouble(row, column, &value->number);
+        break;
+    default:
+        return GS_RESULT_OK;
+    }
+    value->isNull = GS_SUCCEEDED(ret) && value->integer == 0 &&
+            value->number == 0 && value->bytes.empty() &&
+            isNullField(row, column);
+    return ret;
+}
+
+Napi::Value toNapiValue(const Napi::Env &env,
+        const FieldValue &value) {
+    if (value.isNull) {
+        return env.Null();
+    }
+    switch (value.type) {
+    case GS_TYPE_STRING:
+    case GS_TYPE_GEOMETRY:
+        return Napi::String::New(env, value.bytes);
+    case GS_TYPE_BLOB:
+        return Napi::Buffer<char>::Copy(env, value.bytes.data(),
+                value.bytes.size());
+    case GS_TYPE_BOOL:
+        return Napi::Boolean::New(env, value.integer != 0);
+    case GS_TYPE_BYTE:
+    case GS_TYPE_SHORT:
+    case GS_TYPE_INTEGER:
+    case GS_TYPE_LONG:
+        return Napi::Number::New(env, static_cast<double>(value.integer));
+    case GS_TYPE_TIMESTAMP: {
+        GSTimestamp timestamp = value.integer;
+        return Util::fromTimestamp(env, &timestamp);
+    }
+    case GS_TYPE_FLOAT:
+    case GS_TYPE_DOUBLE:
+        return Napi::Number::New(env, value.number);
+    default:
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Type is not support.")
+    }
+    return env.Null();
+}
+
+void readInputValue(const Napi::Value &value, InputValue *input) {
+    input->number = 0;
+    input->bytes.clear();
+    if (value.IsNull() || value.IsUndefined()) {
+        input->kind = InputValue::INPUT_NULL;
+    } else if (value.IsNumber()) {
+        input->kind = InputValue::INPUT_NUMBER;
+        input->number = value.As<Napi::Number>().DoubleValue();
+    } else if (value.IsBoolean()) {
+        input->kind = InputValue::INPUT_BOOL;
+        input->number = value.As<Napi::Boolean>().Value() ? 1 : 0;
+    } else if (value.IsString()) {
+        input->kind = InputValue::INPUT_STRING;
+        input->bytes = value.As<Napi::String>().Utf8Value();
+#if (NAPI_VERSION > 4)
+    } else if (value.IsDate()) {
+        input->kind = InputValue::INPUT_DATE;
+        input->number = value.As<Napi::Date>().ValueOf();
+#endif
+    } else if (value.IsBuffer()) {
+        input->kind = InputValue::INPUT_BUFFER;
+        Napi::Buffer<char> buffer = value.As<Napi::Buffer<char> >();
+        input->bytes.assign(buffer.Data(), buffer.Length());
+    } else {
+        input->kind = InputValue::INPUT_OTHER;
+    }
+}
+
+// Same as Napi::Number::Int32Value
+static int32_t toInt32(double value) {
+    if (!std::isfinite(value)) {
+        return 0;
+    }
+    double modulo = std::fmod(std::trunc(value), 4294967296.0);
+    if (modulo < 0) {
+        modulo += 4294967296.0;
+    }
+    return static_cast<int32_t>(static_cast<uint32_t>(modulo));
+}
+
+// Same as Napi::Number::Int64Value
+static int64_t toInt64(double value) {
+    if (!std::isfinite(value)) {
+        return 0;
+    }
+    if (value >= 9223372036854775808.0) {
+        return std::numeric_limits<int64_t>::max();
+    }
+    if (value <= -9223372036854775808.0) {
+        return std::numeric_limits<int64_t>::min();
+    }
+    return static_cast<int64_t>(value);
+}
+
+/**
+ * @brief Set field from copied JS value. Messages are the ones of
+ *   Util::toField
+ * @param input Value made by readInputValue()
+ * @param *row Row to set
+ * @param column Column number
+ * @param type Column type
+ * @param *ret Result of failed C-API call, GS_RESULT_OK for wrong input
+ * @return NULL on success or error message
+ */
+const char* writeInputValue(const InputValue &input, GSRow *row, int column,
+        GSType type, GSResult *ret) {
+    *ret = GS_RESULT_OK;
+    if (input.kind == InputValue::INPUT_NULL) {
+        *ret = gsSetRowFieldNull(row, column);
+        return GS_SUCCEEDED(*ret) ? NULL : "Can't set null field";
+    }
+    bool isNumber = input.kind == InputValue::INPUT_NUMBER;
+    switch (type) {
+    case GS_TYPE_STRING:
+        if (input.kind != InputValue::INPUT_STRING) {
+            return "Input error, should be string";
+        }
+        *ret = gsSetRowFieldByString(row, column, input.bytes.c_str());
+        Metrics::add(COUNTER_BYTES_WRITTEN, input.bytes.size());
+        break;
+    case GS_TYPE_LONG: {
+        if (!isNumber) {
+            return "Input error, should be long";
+        }
+        int64_t longVal = toInt64(input.number);
+        if (!(MIN_LONG <= longVal && MAX_LONG >= longVal)) {
+            return "Input error, should be in range of long";
+        }
+        *ret = gsSetRowFieldByLong(row, column, longVal);
+        break;
+    }
+    case GS_TYPE_BOOL:
+        if (!isNumber && input.kind != InputValue::INPUT_BOOL) {
+            return "Input error, should be bool";
+        }
+        *ret = gsSetRowFieldByBool(row, column,
+                (input.number != 0 && !std::isnan(input.number)) ?
+                GS_TRUE : GS_FALSE);
+        break;
+    case GS_TYPE_BYTE: {
+        if (!isNumber) {
+            return "Input error, should be byte";
+        }
+        int32_t value = toInt32(input.number);
+        if (value < std::numeric_limits<int8_t>::min() ||
+                value > std::numeric_limits<int8_t>::max()) {
+            return "Input error, should be in range of byte";
+        }
+        *ret = gsSetRowFieldByByte(row, column, static_cast<int8_t>(value));
+        break;
+    }
+    case GS_TYPE_SHORT: {
+        if (!isNumber) {
+            return "Input error, should be short";
+        }
+        int32_t value = toInt32(input.number);
+        if (value < std::numeric_limits<int16_t>::min() ||
+                value > std::numeric_limits<int16_t>::max()) {
+            return "Input error, should be in range of short";
+        }
+        *ret = gsSetRowFieldByShort(row, column,
+                static_cast<int16_t>(value));
+        break;
+    }
+    case GS_TYPE_INTEGER:
+        if (!isNumber) {
+            return "Input error, should be integer";
+        }
+        *ret = gsSetRowFieldByInteger(row, column, toInt32(input.number));
+        break;
+    case GS_TYPE_FLOAT:
+        if (!isNumber) {
+            return "Input error, should be float";
+        }
+        *ret = gsSetRowFieldByFloat(row, column,
+                static_cast<float>(input.number));
+        break;
+    case GS_TYPE_DOUBLE:
+        if (!isNumber) {
+            return "Input error, should be double";
+        }
+        *ret = gsSetRowFieldByDouble(row, column, input.number);
+        break;
+    case GS_TYPE_TIMESTAMP: {
+        GSTimestamp timestamp;
+        if (input.kind == InputValue::INPUT_DATE) {
+            timestamp = static_cast<GSTimestamp>(input.number);
+        } else if (input.kind == InputValue::INPUT_STRING) {
+            if (gsParseTime(input.bytes.c_str(), &timestamp) != GS_TRUE) {
+                return "Invalid date time string";
+            }
+        } else if (isNumber) {
+            timestamp = toInt64(input.number);
+            if (timestamp > (UTC_TIMESTAMP_MAX * 1000)) {
+                return "Invalid timestamp";
+            }
+        } else {
+            return "Invalid input";
+        }
+        *ret = gsSetRowFieldByTimestamp(row, column, timestamp);
+        break;
+    }
+    case GS_TYPE_BLOB: {
+        if (input.kind != InputValue::INPUT_BUFFER) {
+            return "Input error, should be buffer";
+        }
+        GSBlob blob;
+        blob.data = input.bytes.data();
+        blob.size = input.bytes.size();
+        *ret = gsSetRowFieldByBlob(row, column, &blob);
+        Metrics::add(COUNTER_BYTES_WRITTEN, input.bytes.size());
+        break;
+    }
+    default:
+        return "Type is not support";
+    }
+    return GS_SUCCEEDED(*ret) ? NULL : "Can't set field";
+}
+
+}  // namespace griddb
@@ -0,0 +1,67 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef FIELDVALUE_H
+#define FIELDVALUE_H
+
+#include <napi.h>
+#include <string>
+#include "gridstore.h"
+
+namespace griddb {
+
+// Field value copied out of GSRow
+struct FieldValue {
+    GSType type;
+    bool isNull;
+    // BOOL, BYTE, SHORT, INTEGER, LONG and TIMESTAMP
+    int64_t integer;
+    // FLOAT and DOUBLE
+    double number;
+    // STRING, GEOMETRY and BLOB
+    std::string bytes;
+};
+
+// Copy field of row of type
+GSResult readFieldValue(GSRow *row, int column, GSType type,
+        FieldValue *value);
+// Convert to JS value as Util::fromField does. Throw Napi::Error
+Napi::Value toNapiValue(const Napi::Env &env, const FieldValue &value);
+
+// JS value copied on the JS thread, written into a field of a column type
+// known later, possibly off the JS thread
+struct InputValue {
+    enum Kind {
+        INPUT_NULL, INPUT_NUMBER, INPUT_BOOL, INPUT_STRING, INPUT_DATE,
+        INPUT_BUFFER, INPUT_OTHER
+    };
+    Kind kind;
+    // NUMBER, DATE in milliseconds and BOOL as 0 or 1
+    double number;
+    // STRING and BUFFER
+    std::string bytes;
+};
+
+// Copy JS value, null and undefined give INPUT_NULL
+void readInputValue(const Napi::Value &value, InputValue *input);
+// Set field of type with the rules of Util::toField without N-API calls.
+// Return NULL on success or error message, *ret is set to result of C-API
+const char* writeInputValue(const InputValue &input, GSRow *row, int column,
+        GSType type, GSResult *ret);
+
+}  // namespace griddb
+
+#endif  // FIELDVALUE_H
@@ -99,6 +99,41 @@ Napi::Object GSException::New(Napi::Env env, GSResult code,
     });
 #endif
 }
+Napi::Object GSException::New(Napi::Env env, const GSErrorDetail &detail) {
+    return New(env, detail.code, detail.message.c_str(), NULL, NULL);
+}
+
+GSErrorDetail::GSErrorDetail() :
+        code(GS_RESULT_OK) {
+}
+
+/**
+ * @brief Keep error code and top error message of resource.
+ *   Must be called before resource is used again by any other thread.
+ * @param ret Error code returned by C-API
+ * @param resource C-API resource which returned ret
+ */
+void GSErrorDetail::capture(GSResult ret, void* resource) {
+    code = ret;
+    message = "Error with number " + std::to_string(ret);
+    if (resource != NULL && gsGetErrorStackSize(resource) > 0) {
+        GSChar buffer[BUFF_SIZE] = {0};
+        size_t length = gsFormatErrorMessage(resource, 0, buffer, BUFF_SIZE);
+        if (length > 0) {
+            message += ": " + std::string(buffer, length);
+        }
+    }
+}
+
+void GSErrorDetail::capture(const std::string &msg) {
+    code = DEFAULT_ERROR_CODE;
+    message = msg;
+}
+
+bool GSErrorDetail::failed() const {
+    return code != GS_RESULT_OK;
+}
+
 GSException::~GSException() {
 }
 Napi::Value GSException::isTimeout(const Napi::CallbackInfo& info) {
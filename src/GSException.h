@@ -26,6 +26,19 @@
 #define BUFF_SIZE 1024
 
 namespace griddb {
+
+// Error captured on a worker thread, where no Napi::Env is available.
+// It is turned into a GSException once back on the JS thread.
+struct GSErrorDetail {
+    GSResult code;
+    std::string message;
+
+    GSErrorDetail();
+    void capture(GSResult ret, void* resource);
+    void capture(const std::string &msg);
+    bool failed() const;
+};
+
 class GSException : public Napi::ObjectWrap<GSException>{
  public:
 #if NAPI_VERSION <= 5
@@ -38,6 +51,7 @@ class GSException : public Napi::ObjectWrap<GSException>{
             void* resource = NULL);
     static Napi::Object New(Napi::Env env, GSResult code, const char* message,
             const char* location, void* resource = NULL);
+    static Napi::Object New(Napi::Env env, const GSErrorDetail &detail);
     explicit GSException(const Napi::CallbackInfo& info);
     virtual ~GSException();
     Napi::Value isTimeout(const Napi::CallbackInfo& info);
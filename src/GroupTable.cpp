@@ -0,0 +1,142 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "GroupTable.h"
+#include <string.h>
+
+#define GROUP_TABLE_INITIAL_SLOTS 64
+
+namespace griddb {
+
+/**
+ * @brief FNV-1a hash of bytes
+ */
+uint64_t hashBytes(const void *data, size_t length) {
+    const unsigned char *bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Keep probing slots for at most half of the table
+static bool needGrow(size_t count, size_t slotCount) {
+    return (count + 1) * 2 > slotCount;
+}
+
+// Fill slots again for new slot count
+static void rehash(const std::vector<uint64_t> &hashList,
+        std::vector<uint32_t> *slotList) {
+    size_t mask = slotList->size() - 1;
+    for (size_t i = 0; i < hashList.size(); i++) {
+        size_t slot = hashList[i] & mask;
+        while ((*slotList)[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        (*slotList)[slot] = static_cast<uint32_t>(i + 1);
+    }
+}
+
+StringInterner::StringInterner() : mSlotList(GROUP_TABLE_INITIAL_SLOTS, 0) {
+}
+
+/**
+ * @brief Get id of string, add it if not found
+ * @param *str String bytes
+ * @param length Number of bytes
+ * @return String id
+ */
+uint32_t StringInterner::intern(const char *str, size_t length) {
+    uint64_t hash = hashBytes(str, length);
+    size_t mask = mSlotList.size() - 1;
+    size_t slot = hash & mask;
+    for (; mSlotList[slot] != 0; slot = (slot + 1) & mask) {
+        uint32_t id = mSlotList[slot] - 1;
+        if (mHashList[id] == hash && mStringList[id].size() == length &&
+                memcmp(mStringList[id].data(), str, length) == 0) {
+            return id;
+        }
+    }
+    uint32_t id = static_cast<uint32_t>(mStringList.size());
+    mStringList.push_back(std::string(str, length));
+    mHashList.push_back(hash);
+    mSlotList[slot] = id + 1;
+    if (needGrow(mStringList.size(), mSlotList.size())) {
+        grow();
+    }
+    return id;
+}
+
+const std::string& StringInterner::at(uint32_t id) const {
+    return mStringList[id];
+}
+
+size_t StringInterner::size() const {
+    return mStringList.size();
+}
+
+void StringInterner::grow() {
+    mSlotList.assign(mSlotList.size() * 2, 0);
+    rehash(mHashList, &mSlotList);
+}
+
+GroupTable::GroupTable(size_t keyWidth) : mKeyWidth(keyWidth),
+        mSlotList(GROUP_TABLE_INITIAL_SLOTS, 0) {
+}
+
+/**
+ * @brief Get group number of key, add new group if not found
+ * @param *key Key words, as many as keyWidth
+ * @return Group number
+ */
+uint32_t GroupTable::findOrInsert(const uint64_t *key) {
+    size_t keySize = mKeyWidth * sizeof(uint64_t);
+    uint64_t hash = hashBytes(key, keySize);
+    size_t mask = mSlotList.size() - 1;
+    size_t slot = hash & mask;
+    for (; mSlotList[slot] != 0; slot = (slot + 1) & mask) {
+        uint32_t group = mSlotList[slot] - 1;
+        if (mHashList[group] == hash &&
+                memcmp(&mKeyList[group * mKeyWidth], key, keySize) == 0) {
+            return group;
+        }
+    }
+    uint32_t group = static_cast<uint32_t>(mHashList.size());
+    mKeyList.insert(mKeyList.end(), key, key + mKeyWidth);
+    mHashList.push_back(hash);
+    mSlotList[slot] = group + 1;
+    if (needGrow(mHashList.size(), mSlotList.size())) {
+        grow();
+    }
+    return group;
+}
+
+size_t GroupTable::groupCount() const {
+    return mHashList.size();
+}
+
+const uint64_t* GroupTable::keyAt(uint32_t group) const {
+    return &mKeyList[group * mKeyWidth];
+}
+
+void GroupTable::grow() {
+    mSlotList.assign(mSlotList.size() * 2, 0);
+    rehash(mHashList, &mSlotList);
+}
+
+}  // namespace griddb
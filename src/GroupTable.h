@@ -0,0 +1,71 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GROUPTABLE_H
+#define GROUPTABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace griddb {
+
+// Strings are stored once and identified by number in insertion order.
+// Open addressing with linear probing, so looking up an existing string
+// does not copy it
+class StringInterner {
+ public:
+    StringInterner();
+
+    uint32_t intern(const char *str, size_t length);
+    const std::string& at(uint32_t id) const;
+    size_t size() const;
+
+ private:
+    std::vector<std::string> mStringList;
+    std::vector<uint64_t> mHashList;
+    // String id + 1 by slot, 0 for empty slot
+    std::vector<uint32_t> mSlotList;
+
+    void grow();
+};
+
+// Groups identified by fixed number of 64 bit key words, numbered in
+// insertion order. Open addressing with linear probing
+class GroupTable {
+ public:
+    explicit GroupTable(size_t keyWidth);
+
+    uint32_t findOrInsert(const uint64_t *key);
+    size_t groupCount() const;
+    const uint64_t* keyAt(uint32_t group) const;
+
+ private:
+    size_t mKeyWidth;
+    std::vector<uint64_t> mKeyList;
+    std::vector<uint64_t> mHashList;
+    // Group number + 1 by slot, 0 for empty slot
+    std::vector<uint32_t> mSlotList;
+
+    void grow();
+};
+
+uint64_t hashBytes(const void *data, size_t length);
+
+}  // namespace griddb
+
+#endif  // GROUPTABLE_H
@@ -39,6 +39,11 @@ template <typename T> void GSDefaultFini(Napi::Env, T* data) {
         var = obj.Get(name).As<Napi::Number>().Int32Value();    \
     }
 
+#define OPTIONAL_MEMBER_BOOL(var, name, obj)                  \
+    if (obj.Has(name) && obj.Get(name).IsBoolean()) {          \
+        var = obj.Get(name).As<Napi::Boolean>().Value();    \
+    }
+
 #define ADD_MEMBER_OPTIONAL_STRING(props, idx, name, obj, str)        \
     if (obj.Has(name) && obj.Get(name).IsString()) {          \
         str = obj.Get(name).As<Napi::String>().Utf8Value();    \
@@ -0,0 +1,583 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Metrics.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+#include "GSException.h"
+#include "Macro.h"
+
+namespace griddb {
+
+static const char* const METRIC_OP_NAMES[] = {
+    "putRow", "putMultipleRows", "getRow", "deleteRow", "fetch", "fetchAll",
+    "putMultipleContainerRows", "getMultipleContainerRows", "containerDdl"
+};
+
+static const char* const METRIC_TYPE_NAMES[] = {
+    "collection", "timeSeries", "none"
+};
+
+// Quantiles in snapshot
+static const double METRIC_QUANTILES[] = { 0.5, 0.9, 0.99, 0.999 };
+static const char* const METRIC_QUANTILE_NAMES[] = {
+    "p50", "p90", "p99", "p999"
+};
+#define METRIC_QUANTILE_COUNT 4
+
+static const char* const PHASE_CALL_NAMES[] = {
+    "Container.put", "Container.get", "Container.multiPut", "Query.fetch",
+    "RowSet.next", "Store.multiPut", "Store.multiGet", "Store.fetchAll",
+    "Container.putPacked"
+};
+
+static const char* const PHASE_NAMES[] = {
+    "convert", "execute", "build", "cleanup"
+};
+
+// Types of open handles, in order of MetricGauge from GAUGE_OPEN_STORES
+static const char* const HANDLE_TYPE_NAMES[] = {
+    "store", "container", "query", "rowSet"
+};
+#define HANDLE_TYPE_COUNT 4
+
+static const char* const PHASE_TIMING_MODE_NAMES[] = {
+    "off", "on", "debug"
+};
+
+#define NANOS_PER_SECOND 1e9
+
+// Bucket upper bounds of Prometheus histograms in nanoseconds, +Inf follows
+static const int64_t PROMETHEUS_BUCKETS[] = {
+    50000, 100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000,
+    25000000, 50000000, 100000000, 250000000, 500000000, 1000000000,
+    2500000000LL, 5000000000LL, 10000000000LL
+};
+#define PROMETHEUS_BUCKET_COUNT 17
+
+// Prometheus names of counters and gauges, help text follows each name
+static const char* const PROMETHEUS_COUNTERS[][2] = {
+    { "griddb_client_rows_read_total",
+            "Rows read from GridDB" },
+    { "griddb_client_rows_written_total",
+            "Rows written to GridDB" },
+    { "griddb_client_bytes_read_total",
+            "Bytes of variable length values read from rows" },
+    { "griddb_client_bytes_written_total",
+            "Bytes of variable length values written to rows" },
+    { "griddb_client_row_cache_hits_total",
+            "Container.get calls served by row cache" },
+    { "griddb_client_row_cache_misses_total",
+            "Container.get calls not served by row cache" },
+    { "griddb_client_row_cache_evictions_total",
+            "Rows evicted from row cache" }
+};
+
+LatencyHistogram Metrics::sHistogramList[METRIC_OP_COUNT][METRIC_TYPE_COUNT];
+std::atomic<int> Metrics::sPhaseTimingMode(PHASE_TIMING_OFF);
+std::atomic<uint64_t> Metrics::sPhaseCountList[CALL_COUNT];
+std::atomic<int64_t> Metrics::sPhaseTimeList[CALL_COUNT][PHASE_COUNT];
+std::atomic<uint64_t> Metrics::sCounterList[COUNTER_COUNT];
+std::atomic<int64_t> Metrics::sGaugeList[GAUGE_COUNT];
+std::mutex Metrics::sErrorMutex;
+std::map<GSResult, uint64_t> Metrics::sErrorCodeMap;
+static thread_local uint64_t tThreadBytes = 0;
+
+LatencyHistogram::LatencyHistogram() :
+        mCount(0), mErrors(0), mSum(0), mMax(0) {
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        mBucketList[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+int LatencyHistogram::bucketOf(int64_t nanos) {
+    if (nanos < LATENCY_SUB_COUNT) {
+        return nanos < 0 ? 0 : static_cast<int>(nanos);
+    }
+#if defined(__GNUC__)
+    int magnitude = 63 - __builtin_clzll(static_cast<uint64_t>(nanos));
+#else
+    int magnitude = 0;
+    for (uint64_t value = static_cast<uint64_t>(nanos) >> 1; value != 0;
+            value >>= 1) {
+        magnitude++;
+    }
+#endif
+    if (magnitude > LATENCY_MAX_MAGNITUDE) {
+        return LATENCY_BUCKET_COUNT - 1;
+    }
+    int shift = magnitude - LATENCY_SUB_BITS;
+    int sub = static_cast<int>(nanos >> shift) - LATENCY_SUB_COUNT;
+    return LATENCY_SUB_COUNT * (shift + 1) + sub;
+}
+
+// Middle of bucket
+int64_t LatencyHistogram::bucketValue(int bucket) {
+    if (bucket < LATENCY_SUB_COUNT) {
+        return bucket;
+    }
+    int shift = bucket / LATENCY_SUB_COUNT - 1;
+    int64_t lower = static_cast<int64_t>(
+            LATENCY_SUB_COUNT + bucket % LATENCY_SUB_COUNT) << shift;
+    return lower + ((static_cast<int64_t>(1) << shift) >> 1);
+}
+
+int64_t LatencyHistogram::bucketUpper(int bucket) {
+    if (bucket < LATENCY_SUB_COUNT) {
+        return bucket + 1;
+    }
+    int shift = bucket / LATENCY_SUB_COUNT - 1;
+    return static_cast<int64_t>(
+            LATENCY_SUB_COUNT + bucket % LATENCY_SUB_COUNT + 1) << shift;
+}
+
+void LatencyHistogram::loadBuckets(uint64_t *counts) const {
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        counts[i] = mBucketList[i].load(std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::record(int64_t nanos, bool error) {
+    mBucketList[bucketOf(nanos)].fetch_add(1, std::memory_order_relaxed);
+    mCount.fetch_add(1, std::memory_order_relaxed);
+    mSum.fetch_add(nanos, std::memory_order_relaxed);
+    if (error) {
+        mErrors.fetch_add(1, std::memory_order_relaxed);
+    }
+    int64_t max = mMax.load(std::memory_order_relaxed);
+    while (nanos > max && !mMax.compare_exchange_weak(max, nanos,
+            std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t LatencyHistogram::count() const {
+    return mCount.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::errors() const {
+    return mErrors.load(std::memory_order_relaxed);
+}
+
+int64_t LatencyHistogram::sum() const {
+    return mSum.load(std::memory_order_relaxed);
+}
+
+int64_t LatencyHistogram::max() const {
+    return mMax.load(std::memory_order_relaxed);
+}
+
+int64_t LatencyHistogram::quantile(double q) const {
+    uint64_t counts[LATENCY_BUCKET_COUNT];
+    uint64_t total = 0;
+    loadBuckets(counts);
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(q * total));
+    if (rank == 0) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::min(bucketValue(i), max());
+        }
+    }
+    return max();
+}
+
+PhaseTimer::PhaseTimer(PhaseCall call) :
+        mCall(call), mMode(Metrics::phaseTimingMode()), mPhase(-1),
+        mStartTime(0), mElapsed() {
+    if (mMode != PHASE_TIMING_OFF) {
+        enter(PHASE_CONVERT);
+    }
+}
+
+void PhaseTimer::enter(MetricPhase phase) {
+    if (mMode == PHASE_TIMING_OFF) {
+        return;
+    }
+    int64_t time = Metrics::now();
+    if (mPhase >= 0) {
+        mElapsed[mPhase] += time - mStartTime;
+    }
+    mPhase = phase;
+    mStartTime = time;
+}
+
+void PhaseTimer::finish() {
+    if (mMode == PHASE_TIMING_OFF || mPhase < 0) {
+        return;
+    }
+    mElapsed[mPhase] += Metrics::now() - mStartTime;
+    mPhase = -1;
+    Metrics::addPhases(mCall, mElapsed);
+}
+
+void PhaseTimer::finish(Napi::Object target) {
+    finish();
+    if (mMode != PHASE_TIMING_DEBUG) {
+        return;
+    }
+    Napi::Env env = target.Env();
+    Napi::Object phases = Napi::Object::New(env);
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        phases.Set(PHASE_NAMES[i],
+                Napi::Number::New(env, mElapsed[i] / NANOS_PER_MILLI));
+    }
+    target.Set("phases", phases);
+}
+
+void Metrics::init(Napi::Env env, Napi::Object exports) {
+    Napi::Function metrics = Napi::Function::New(env, &Metrics::snapshot,
+            "metrics");
+    metrics.Set("phases", Napi::Function::New(env, &Metrics::phases,
+            "phases"));
+    metrics.Set("setPhaseTiming", Napi::Function::New(env,
+            &Metrics::setPhaseTiming, "setPhaseTiming"));
+    metrics.Set("handles", Napi::Function::New(env, &Metrics::handles,
+            "handles"));
+    metrics.Set("prometheus", Napi::Function::New(env, &Metrics::prometheus,
+            "prometheus"));
+    exports.Set("metrics", metrics);
+}
+
+int64_t Metrics::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t Metrics::begin() {
+    sGaugeList[GAUGE_IN_FLIGHT_CALLS].fetch_add(1, std::memory_order_relaxed);
+    return now();
+}
+
+/**
+ * @brief Record latency of C-client call started by begin()
+ * @param containerType GSContainerType or METRIC_NO_CONTAINER_TYPE
+ */
+void Metrics::record(MetricOp op, int containerType, int64_t startTime,
+        GSResult ret) {
+    bool error = !GS_SUCCEEDED(ret);
+    histogram(op, containerType).record(now() - startTime, error);
+    sGaugeList[GAUGE_IN_FLIGHT_CALLS].fetch_sub(1, std::memory_order_relaxed);
+    if (error) {
+        std::lock_guard<std::mutex> lock(sErrorMutex);
+        sErrorCodeMap[ret]++;
+    }
+}
+
+void Metrics::add(MetricCounter counter, uint64_t value) {
+    sCounterList[counter].fetch_add(value, std::memory_order_relaxed);
+    if (counter == COUNTER_BYTES_READ || counter == COUNTER_BYTES_WRITTEN) {
+        tThreadBytes += value;
+    }
+}
+
+void Metrics::addGauge(MetricGauge gauge, int64_t delta) {
+    sGaugeList[gauge].fetch_add(delta, std::memory_order_relaxed);
+}
+
+uint64_t Metrics::threadBytes() {
+    return tThreadBytes;
+}
+
+LatencyHistogram& Metrics::histogram(MetricOp op, int containerType) {
+    int typeIndex = containerType == GS_CONTAINER_COLLECTION ||
+            containerType == GS_CONTAINER_TIME_SERIES ?
+            containerType : METRIC_TYPE_COUNT - 1;
+    return sHistogramList[op][typeIndex];
+}
+
+const char* Metrics::opName(MetricOp op) {
+    return METRIC_OP_NAMES[op];
+}
+
+const char* Metrics::typeName(int typeIndex) {
+    return METRIC_TYPE_NAMES[typeIndex];
+}
+
+/**
+ * @brief Snapshot of recorded operations
+ * @return {operation: {containerType: {count, errors, mean, p50, p90, p99,
+ *   p999, max}}}, times in milliseconds. Container type is "collection",
+ *   "timeSeries" or "none" for operations over containers
+ */
+Napi::Value Metrics::snapshot(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    Napi::Object result = Napi::Object::New(env);
+    for (int op = 0; op < METRIC_OP_COUNT; op++) {
+        Napi::Object byType = Napi::Object::New(env);
+        bool recorded = false;
+        for (int type = 0; type < METRIC_TYPE_COUNT; type++) {
+            const LatencyHistogram &histogram = sHistogramList[op][type];
+            uint64_t count = histogram.count();
+            if (count == 0) {
+                continue;
+            }
+            Napi::Object stats = Napi::Object::New(env);
+            stats.Set("count", Napi::Number::New(env,
+                    static_cast<double>(count)));
+            stats.Set("errors", Napi::Number::New(env,
+                    static_cast<double>(histogram.errors())));
+            stats.Set("mean", Napi::Number::New(env,
+                    histogram.sum() / NANOS_PER_MILLI / count));
+            for (int i = 0; i < METRIC_QUANTILE_COUNT; i++) {
+                stats.Set(METRIC_QUANTILE_NAMES[i], Napi::Number::New(env,
+                        histogram.quantile(METRIC_QUANTILES[i]) /
+                        NANOS_PER_MILLI));
+            }
+            stats.Set("max", Napi::Number::New(env,
+                    histogram.max() / NANOS_PER_MILLI));
+            byType.Set(METRIC_TYPE_NAMES[type], stats);
+            recorded = true;
+        }
+        if (recorded) {
+            result.Set(METRIC_OP_NAMES[op], byType);
+        }
+    }
+    return result;
+}
+
+int Metrics::phaseTimingMode() {
+    return sPhaseTimingMode.load(std::memory_order_relaxed);
+}
+
+void Metrics::addPhases(PhaseCall call, const int64_t *elapsed) {
+    sPhaseCountList[call].fetch_add(1, std::memory_order_relaxed);
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        sPhaseTimeList[call][i].fetch_add(elapsed[i],
+                std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Totals of phases of binding calls since phase timing is enabled
+ * @return {call: {count, convert, execute, build, cleanup}}, times are
+ *   total milliseconds
+ */
+Napi::Value Metrics::phases(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    Napi::Object result = Napi::Object::New(env);
+    for (int call = 0; call < CALL_COUNT; call++) {
+        uint64_t count = sPhaseCountList[call].load(std::memory_order_relaxed);
+        if (count == 0) {
+            continue;
+        }
+        Napi::Object stats = Napi::Object::New(env);
+        stats.Set("count", Napi::Number::New(env,
+                static_cast<double>(count)));
+        for (int i = 0; i < PHASE_COUNT; i++) {
+            stats.Set(PHASE_NAMES[i], Napi::Number::New(env,
+                    sPhaseTimeList[call][i].load(std::memory_order_relaxed) /
+                    NANOS_PER_MILLI));
+        }
+        result.Set(PHASE_CALL_NAMES[call], stats);
+    }
+    return result;
+}
+
+Napi::Value Metrics::setPhaseTiming(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() != 1 || !info[0].IsString()) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
+        return env.Undefined();
+    }
+    std::string mode = info[0].As<Napi::String>().Utf8Value();
+    for (int i = 0; i <= PHASE_TIMING_DEBUG; i++) {
+        if (mode == PHASE_TIMING_MODE_NAMES[i]) {
+            sPhaseTimingMode.store(i, std::memory_order_relaxed);
+            return env.Undefined();
+        }
+    }
+    THROW_EXCEPTION_WITH_STR(env, "Invalid phase timing mode", NULL)
+    return env.Undefined();
+}
+
+/**
+ * @brief Native handles not closed by close() or GC yet
+ * @return {store, container, query, rowSet}
+ */
+Napi::Value Metrics::handles(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    Napi::Object result = Napi::Object::New(env);
+    for (int i = 0; i < HANDLE_TYPE_COUNT; i++) {
+        result.Set(HANDLE_TYPE_NAMES[i], Napi::Number::New(env,
+                static_cast<double>(sGaugeList[GAUGE_OPEN_STORES + i].load(
+                std::memory_order_relaxed))));
+    }
+    return result;
+}
+
+/**
+ * @brief Render all metrics in Prometheus text exposition format 0.0.4
+ * @return String
+ */
+Napi::Value Metrics::prometheus(const Napi::CallbackInfo &info) {
+    std::string out;
+    renderPrometheus(&out);
+    return Napi::String::New(info.Env(), out);
+}
+
+static void appendFormat(std::string *out, const char *format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length > 0) {
+        out->append(buffer, std::min(static_cast<size_t>(length),
+                sizeof(buffer) - 1));
+    }
+}
+
+void Metrics::renderPrometheus(std::string *out) {
+    out->reserve(16384);
+    uint64_t counts[LATENCY_BUCKET_COUNT];
+
+    *out += "# HELP griddb_client_op_duration_seconds "
+            "Latency of GridDB C-client calls\n"
+            "# TYPE griddb_client_op_duration_seconds histogram\n";
+    for (int op = 0; op < METRIC_OP_COUNT; op++) {
+        for (int type = 0; type < METRIC_TYPE_COUNT; type++) {
+            const LatencyHistogram &histogram = sHistogramList[op][type];
+            if (histogram.count() == 0) {
+                continue;
+            }
+            histogram.loadBuckets(counts);
+            uint64_t cumulative = 0;
+            int bucket = 0;
+            for (int i = 0; i < PROMETHEUS_BUCKET_COUNT; i++) {
+                // Native buckets straddling a bound are counted above it
+                while (bucket < LATENCY_BUCKET_COUNT &&
+                        LatencyHistogram::bucketUpper(bucket) <=
+                        PROMETHEUS_BUCKETS[i] + 1) {
+                    cumulative += counts[bucket++];
+                }
+                appendFormat(out, "griddb_client_op_duration_seconds_bucket"
+                        "{op=\"%s\",container_type=\"%s\",le=\"%g\"} %llu\n",
+                        METRIC_OP_NAMES[op], METRIC_TYPE_NAMES[type],
+                        PROMETHEUS_BUCKETS[i] / NANOS_PER_SECOND,
+                        static_cast<unsigned long long>(cumulative));
+            }
+            while (bucket < LATENCY_BUCKET_COUNT) {
+                cumulative += counts[bucket++];
+            }
+            appendFormat(out, "griddb_client_op_duration_seconds_bucket"
+                    "{op=\"%s\",container_type=\"%s\",le=\"+Inf\"} %llu\n",
+                    METRIC_OP_NAMES[op], METRIC_TYPE_NAMES[type],
+                    static_cast<unsigned long long>(cumulative));
+            appendFormat(out, "griddb_client_op_duration_seconds_sum"
+                    "{op=\"%s\",container_type=\"%s\"} %.9g\n",
+                    METRIC_OP_NAMES[op], METRIC_TYPE_NAMES[type],
+                    histogram.sum() / NANOS_PER_SECOND);
+            appendFormat(out, "griddb_client_op_duration_seconds_count"
+                    "{op=\"%s\",container_type=\"%s\"} %llu\n",
+                    METRIC_OP_NAMES[op], METRIC_TYPE_NAMES[type],
+                    static_cast<unsigned long long>(cumulative));
+        }
+    }
+
+    *out += "# HELP griddb_client_op_errors_total "
+            "Failed GridDB C-client calls\n"
+            "# TYPE griddb_client_op_errors_total counter\n";
+    for (int op = 0; op < METRIC_OP_COUNT; op++) {
+        for (int type = 0; type < METRIC_TYPE_COUNT; type++) {
+            const LatencyHistogram &histogram = sHistogramList[op][type];
+            if (histogram.count() == 0) {
+                continue;
+            }
+            appendFormat(out, "griddb_client_op_errors_total"
+                    "{op=\"%s\",container_type=\"%s\"} %llu\n",
+                    METRIC_OP_NAMES[op], METRIC_TYPE_NAMES[type],
+                    static_cast<unsigned long long>(histogram.errors()));
+        }
+    }
+
+    *out += "# HELP griddb_client_errors_by_code_total "
+            "Failed GridDB C-client calls by error code\n"
+            "# TYPE griddb_client_errors_by_code_total counter\n";
+    {
+        std::lock_guard<std::mutex> lock(sErrorMutex);
+        for (std::map<GSResult, uint64_t>::const_iterator it =
+                sErrorCodeMap.begin(); it != sErrorCodeMap.end(); ++it) {
+            appendFormat(out, "griddb_client_errors_by_code_total"
+                    "{code=\"%d\"} %llu\n", static_cast<int>(it->first),
+                    static_cast<unsigned long long>(it->second));
+        }
+    }
+
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        appendFormat(out, "# HELP %s %s\n# TYPE %s counter\n%s %llu\n",
+                PROMETHEUS_COUNTERS[i][0], PROMETHEUS_COUNTERS[i][1],
+                PROMETHEUS_COUNTERS[i][0], PROMETHEUS_COUNTERS[i][0],
+                static_cast<unsigned long long>(
+                sCounterList[i].load(std::memory_order_relaxed)));
+    }
+
+    appendFormat(out, "# HELP griddb_client_in_flight_calls "
+            "GridDB C-client calls in progress\n"
+            "# TYPE griddb_client_in_flight_calls gauge\n"
+            "griddb_client_in_flight_calls %lld\n",
+            static_cast<long long>(sGaugeList[GAUGE_IN_FLIGHT_CALLS].load(
+            std::memory_order_relaxed)));
+    appendFormat(out, "# HELP griddb_client_pool_handles "
+            "Pooled GridStore handles of workers by state\n"
+            "# TYPE griddb_client_pool_handles gauge\n"
+            "griddb_client_pool_handles{state=\"in_use\"} %lld\n"
+            "griddb_client_pool_handles{state=\"idle\"} %lld\n",
+            static_cast<long long>(sGaugeList[GAUGE_POOL_HANDLES_IN_USE].load(
+            std::memory_order_relaxed)),
+            static_cast<long long>(sGaugeList[GAUGE_POOL_HANDLES_IDLE].load(
+            std::memory_order_relaxed)));
+
+    *out += "# HELP griddb_client_open_handles "
+            "Native handles not closed yet by type\n"
+            "# TYPE griddb_client_open_handles gauge\n";
+    for (int i = 0; i < HANDLE_TYPE_COUNT; i++) {
+        appendFormat(out, "griddb_client_open_handles{type=\"%s\"} %lld\n",
+                HANDLE_TYPE_NAMES[i], static_cast<long long>(
+                sGaugeList[GAUGE_OPEN_STORES + i].load(
+                std::memory_order_relaxed)));
+    }
+
+    *out += "# HELP griddb_client_phase_seconds_total "
+            "Time of binding calls by phase while phase timing is enabled\n"
+            "# TYPE griddb_client_phase_seconds_total counter\n";
+    for (int call = 0; call < CALL_COUNT; call++) {
+        if (sPhaseCountList[call].load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        for (int i = 0; i < PHASE_COUNT; i++) {
+            appendFormat(out, "griddb_client_phase_seconds_total"
+                    "{call=\"%s\",phase=\"%s\"} %.9g\n",
+                    PHASE_CALL_NAMES[call], PHASE_NAMES[i],
+                    sPhaseTimeList[call][i].load(std::memory_order_relaxed) /
+                    NANOS_PER_SECOND);
+        }
+    }
+}
+
+}  // namespace griddb
@@ -0,0 +1,219 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <napi.h>
+#include <stdint.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include "gridstore.h"
+
+// Conversion of Metrics::now() durations to milliseconds
+#define NANOS_PER_MILLI 1e6
+
+// Histogram buckets: values below 2^LATENCY_SUB_BITS nanoseconds have own
+// buckets, larger values have 2^LATENCY_SUB_BITS buckets per power of two
+// up to 2^LATENCY_MAX_MAGNITUDE nanoseconds (about 5 hours)
+#define LATENCY_SUB_BITS 4
+#define LATENCY_SUB_COUNT (1 << LATENCY_SUB_BITS)
+#define LATENCY_MAX_MAGNITUDE 44
+#define LATENCY_BUCKET_COUNT \
+    (LATENCY_SUB_COUNT * (LATENCY_MAX_MAGNITUDE - LATENCY_SUB_BITS + 2))
+
+namespace griddb {
+
+// C-client operations measured
+enum MetricOp {
+    METRIC_PUT_ROW,
+    METRIC_PUT_MULTIPLE_ROWS,
+    METRIC_GET_ROW,
+    METRIC_DELETE_ROW,
+    METRIC_FETCH,
+    METRIC_FETCH_ALL,
+    METRIC_PUT_MULTIPLE_CONTAINER_ROWS,
+    METRIC_GET_MULTIPLE_CONTAINER_ROWS,
+    METRIC_CONTAINER_DDL,
+    METRIC_OP_COUNT
+};
+
+// Binding calls with phase timers
+enum PhaseCall {
+    CALL_CONTAINER_PUT,
+    CALL_CONTAINER_GET,
+    CALL_CONTAINER_MULTI_PUT,
+    CALL_QUERY_FETCH,
+    CALL_ROWSET_NEXT,
+    CALL_STORE_MULTI_PUT,
+    CALL_STORE_MULTI_GET,
+    CALL_STORE_FETCH_ALL,
+    CALL_CONTAINER_PUT_PACKED,
+    CALL_COUNT
+};
+
+// Phases of one binding call: conversion of JS arguments, C-client calls,
+// conversion of results to JS values and release of native resources
+enum MetricPhase {
+    PHASE_CONVERT,
+    PHASE_EXECUTE,
+    PHASE_BUILD,
+    PHASE_CLEANUP,
+    PHASE_COUNT
+};
+
+// Phase timing modes of griddb.metrics.setPhaseTiming()
+enum PhaseTimingMode {
+    PHASE_TIMING_OFF,
+    PHASE_TIMING_ON,
+    // Also attach phases of the call to returned Promise as "phases"
+    PHASE_TIMING_DEBUG
+};
+
+// Process wide counters
+enum MetricCounter {
+    COUNTER_ROWS_READ,
+    COUNTER_ROWS_WRITTEN,
+    // Bytes of STRING, GEOMETRY and BLOB values converted from and to rows
+    COUNTER_BYTES_READ,
+    COUNTER_BYTES_WRITTEN,
+    COUNTER_ROW_CACHE_HITS,
+    COUNTER_ROW_CACHE_MISSES,
+    COUNTER_ROW_CACHE_EVICTIONS,
+    COUNTER_COUNT
+};
+
+// Process wide gauges
+enum MetricGauge {
+    GAUGE_IN_FLIGHT_CALLS,
+    GAUGE_POOL_HANDLES_IN_USE,
+    GAUGE_POOL_HANDLES_IDLE,
+    // Native handles not closed yet
+    GAUGE_OPEN_STORES,
+    GAUGE_OPEN_CONTAINERS,
+    GAUGE_OPEN_QUERIES,
+    GAUGE_OPEN_ROW_SETS,
+    GAUGE_COUNT
+};
+
+// Container type of operations not bound to one container
+#define METRIC_NO_CONTAINER_TYPE -1
+// Collection, time series and no container type
+#define METRIC_TYPE_COUNT 3
+
+// Log-linear latency histogram in nanoseconds, about 6% precision.
+// Lock free, can be recorded from any thread
+class LatencyHistogram {
+ public:
+    LatencyHistogram();
+
+    void record(int64_t nanos, bool error);
+
+    uint64_t count() const;
+    uint64_t errors() const;
+    int64_t sum() const;
+    int64_t max() const;
+    // Value at quantile q, representative value of bucket
+    int64_t quantile(double q) const;
+
+    static int bucketOf(int64_t nanos);
+    static int64_t bucketValue(int bucket);
+    // Exclusive upper bound of bucket
+    static int64_t bucketUpper(int bucket);
+    void loadBuckets(uint64_t *counts) const;
+
+ private:
+    std::atomic<uint64_t> mBucketList[LATENCY_BUCKET_COUNT];
+    std::atomic<uint64_t> mCount;
+    std::atomic<uint64_t> mErrors;
+    std::atomic<int64_t> mSum;
+    std::atomic<int64_t> mMax;
+};
+
+// Times phases of one binding call on the stack. Does nothing unless phase
+// timing is enabled. Calls rejected before finish() are not counted
+class PhaseTimer {
+ public:
+    explicit PhaseTimer(PhaseCall call);
+
+    // End current phase and start phase
+    void enter(MetricPhase phase);
+    // End current phase and add phases to counters. In debug mode, set
+    // phases in milliseconds to target
+    void finish();
+    void finish(Napi::Object target);
+
+ private:
+    PhaseCall mCall;
+    int mMode;
+    int mPhase;
+    int64_t mStartTime;
+    int64_t mElapsed[PHASE_COUNT];
+};
+
+// Process wide latency histograms by operation and container type
+class Metrics {
+ public:
+    static void init(Napi::Env env, Napi::Object exports);
+
+    // Steady clock in nanoseconds
+    static int64_t now();
+    // now() for record(), counts call as in flight until recorded
+    static int64_t begin();
+    static void record(MetricOp op, int containerType, int64_t startTime,
+            GSResult ret);
+    static LatencyHistogram& histogram(MetricOp op, int containerType);
+    static const char* opName(MetricOp op);
+    static const char* typeName(int typeIndex);
+
+    static void add(MetricCounter counter, uint64_t value);
+    static void addGauge(MetricGauge gauge, int64_t delta);
+    // Bytes read and written by current thread
+    static uint64_t threadBytes();
+
+    static int phaseTimingMode();
+    static void addPhases(PhaseCall call, const int64_t *elapsed);
+
+    // griddb.metrics(): snapshot of histograms in milliseconds
+    static Napi::Value snapshot(const Napi::CallbackInfo &info);
+    // griddb.metrics.phases(): total time of phases of binding calls
+    static Napi::Value phases(const Napi::CallbackInfo &info);
+    // griddb.metrics.setPhaseTiming("off" | "on" | "debug")
+    static Napi::Value setPhaseTiming(const Napi::CallbackInfo &info);
+    // griddb.metrics.handles(): open native handles by type
+    static Napi::Value handles(const Napi::CallbackInfo &info);
+    // griddb.metrics.prometheus(): all metrics in Prometheus text format
+    static Napi::Value prometheus(const Napi::CallbackInfo &info);
+
+ private:
+    static LatencyHistogram sHistogramList[METRIC_OP_COUNT][METRIC_TYPE_COUNT];
+    static std::atomic<int> sPhaseTimingMode;
+    static std::atomic<uint64_t> sPhaseCountList[CALL_COUNT];
+    static std::atomic<int64_t> sPhaseTimeList[CALL_COUNT][PHASE_COUNT];
+    static std::atomic<uint64_t> sCounterList[COUNTER_COUNT];
+    static std::atomic<int64_t> sGaugeList[GAUGE_COUNT];
+    // Errors by GSResult code, updated only on errors
+    static std::mutex sErrorMutex;
+    static std::map<GSResult, uint64_t> sErrorCodeMap;
+
+    static void renderPrometheus(std::string *out);
+};
+
+}  // namespace griddb
+
+#endif  // METRICS_H
@@ -0,0 +1,224 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "PackedLayout.h"
+#include <string.h>
+
+// Alignment of records
+#define PACKED_RECORD_ALIGN 8
+// Bytes of heap reference of a variable size field: offset and length
+#define PACKED_HEAP_REF_SIZE 8
+
+namespace griddb {
+
+PackedLayout::PackedLayout(const ContainerSchema &schema) :
+        mBitmapSize((schema.columnCount() + 7) / 8), mRecordSize(0),
+        mUnsupportedColumn(-1) {
+    size_t offset = mBitmapSize;
+    for (size_t i = 0; i < schema.columnCount(); i++) {
+        Column column;
+        column.name = schema.columnName(i);
+        column.type = schema.columnType(i);
+        column.size = fieldSize(column.type);
+        if (column.size == 0 && mUnsupportedColumn < 0) {
+            mUnsupportedColumn = static_cast<int>(i);
+        }
+        // Heap reference is two uint32 values
+        size_t align = column.size;
+        if (column.type == GS_TYPE_STRING ||
+                column.type == GS_TYPE_GEOMETRY ||
+                column.type == GS_TYPE_BLOB) {
+            align = sizeof(uint32_t);
+        }
+        if (align > 1) {
+            offset = (offset + align - 1) / align * align;
+        }
+        column.offset = offset;
+        offset += column.size;
+        mColumnList.push_back(column);
+    }
+    mRecordSize = (offset + PACKED_RECORD_ALIGN - 1) / PACKED_RECORD_ALIGN *
+            PACKED_RECORD_ALIGN;
+}
+
+size_t PackedLayout::fieldSize(GSType type) {
+    switch (type) {
+    case GS_TYPE_BOOL:
+    case GS_TYPE_BYTE:
+        return 1;
+    case GS_TYPE_SHORT:
+        return 2;
+    case GS_TYPE_INTEGER:
+    case GS_TYPE_FLOAT:
+        return 4;
+    case GS_TYPE_LONG:
+    case GS_TYPE_DOUBLE:
+    case GS_TYPE_TIMESTAMP:
+        return 8;
+    case GS_TYPE_STRING:
+    case GS_TYPE_GEOMETRY:
+    case GS_TYPE_BLOB:
+        return PACKED_HEAP_REF_SIZE;
+    default:
+        return 0;
+    }
+}
+
+int PackedLayout::unsupportedColumn() const {
+    return mUnsupportedColumn;
+}
+
+size_t PackedLayout::recordSize() const {
+    return mRecordSize;
+}
+
+/**
+ * @brief Describe the layout
+ * @return {recordSize, nullBitmapSize, columns: [{name, type, offset,
+ *   size}]}, type is a griddb.Type value
+ */
+Napi::Value PackedLayout::toObject(const Napi::Env &env) const {
+    Napi::Object output = Napi::Object::New(env);
+    output.Set("recordSize", static_cast<double>(mRecordSize));
+    output.Set("nullBitmapSize", static_cast<double>(mBitmapSize));
+    Napi::Array columnArray = Napi::Array::New(env, mColumnList.size());
+    for (size_t i = 0; i < mColumnList.size(); i++) {
+        const Column &column = mColumnList[i];
+        Napi::Object item = Napi::Object::New(env);
+        item.Set("name", column.name);
+        item.Set("type", static_cast<double>(column.type));
+        item.Set("offset", static_cast<double>(column.offset));
+        item.Set("size", static_cast<double>(column.size));
+        columnArray.Set(static_cast<uint32_t>(i), item);
+    }
+    output.Set("columns", columnArray);
+    return output;
+}
+
+/**
+ * @brief Fill row from one record without N-API calls
+ * @param *data Whole buffer
+ * @param size Bytes of data
+ * @param rowCount Number of records before the heap
+ * @param rowNo Record to read
+ * @param *row Row of container with the schema of this layout
+ * @param *ret Result of failed C-API call
+ * @param *buffer Work buffer for null terminated strings
+ * @return NULL on success or error message
+ */
+const char* PackedLayout::readRecord(const uint8_t *data, size_t size,
+        size_t rowCount, size_t rowNo, GSRow *row, GSResult *ret,
+        std::string *buffer) const {
+    const uint8_t *record = data + rowNo * mRecordSize;
+    const uint8_t *heap = data + rowCount * mRecordSize;
+    size_t heapSize = size - rowCount * mRecordSize;
+    *ret = GS_RESULT_OK;
+    for (size_t i = 0; i < mColumnList.size(); i++) {
+        const Column &column = mColumnList[i];
+        const uint8_t *field = record + column.offset;
+        int32_t columnNo = static_cast<int32_t>(i);
+        if (record[i / 8] & (1 << (i % 8))) {
+            *ret = gsSetRowFieldNull(row, columnNo);
+            if (!GS_SUCCEEDED(*ret)) {
+                return "Can't set null field";
+            }
+            continue;
+        }
+        switch (column.type) {
+        case GS_TYPE_BOOL:
+            *ret = gsSetRowFieldByBool(row, columnNo,
+                    field[0] ? GS_TRUE : GS_FALSE);
+            break;
+        case GS_TYPE_BYTE: {
+            int8_t value;
+            memcpy(&value, field, sizeof(value));
+            *ret = gsSetRowFieldByByte(row, columnNo, value);
+            break;
+        }
+        case GS_TYPE_SHORT: {
+            int16_t value;
+            memcpy(&value, field, sizeof(value));
+            *ret = gsSetRowFieldByShort(row, columnNo, value);
+            break;
+        }
+        case GS_TYPE_INTEGER: {
+            int32_t value;
+            memcpy(&value, field, sizeof(value));
+            *ret = gsSetRowFieldByInteger(row, columnNo, value);
+            break;
+        }
+        case GS_TYPE_LONG: {
+            int64_t value;
+            memcpy(&value, field, sizeof(value));
+            *ret = gsSetRowFieldByLong(row, columnNo, value);
+            break;
+        }
+        case GS_TYPE_FLOAT: {
+            float value;
+            memcpy(&value, field, sizeof(value));
+            *ret = gsSetRowFieldByFloat(row, columnNo, value);
+            break;
+        }
+        case GS_TYPE_DOUBLE: {
+            double value;
+            memcpy(&value, field, sizeof(value));
+            *ret = gsSetRowFieldByDouble(row, columnNo, value);
+            break;
+        }
+        case GS_TYPE_TIMESTAMP: {
+            GSTimestamp value;
+            memcpy(&value, field, sizeof(value));
+            *ret = gsSetRowFieldByTimestamp(row, columnNo, value);
+            break;
+        }
+        case GS_TYPE_STRING:
+        case GS_TYPE_GEOMETRY:
+        case GS_TYPE_BLOB: {
+            uint32_t offset;
+            uint32_t length;
+            memcpy(&offset, field, sizeof(offset));
+            memcpy(&length, field + sizeof(offset), sizeof(length));
+            if (offset > heapSize || length > heapSize - offset) {
+                return "Heap reference out of buffer";
+            }
+            if (column.type == GS_TYPE_BLOB) {
+                GSBlob blob;
+                blob.size = length;
+                blob.data = heap + offset;
+                *ret = gsSetRowFieldByBlob(row, columnNo, &blob);
+                break;
+            }
+            buffer->assign(reinterpret_cast<const char*>(heap + offset),
+                    length);
+            if (column.type == GS_TYPE_STRING) {
+                *ret = gsSetRowFieldByString(row, columnNo, buffer->c_str());
+            } else {
+                *ret = gsSetRowFieldByGeometry(row, columnNo,
+                        buffer->c_str());
+            }
+            break;
+        }
+        default:
+            return "Type is not support";
+        }
+        if (!GS_SUCCEEDED(*ret)) {
+            return "Can't set field";
+        }
+    }
+    return NULL;
+}
+
+}  // namespace griddb
@@ -0,0 +1,74 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef PACKEDLAYOUT_H
+#define PACKEDLAYOUT_H
+
+#include <napi.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "ContainerSchema.h"
+#include "gridstore.h"
+
+namespace griddb {
+
+// Binary row format of Container.putPacked, derived from the schema.
+// A buffer holds rowCount fixed size records followed by a heap:
+//   record: null bitmap (bit i of byte i / 8 set = column i is null),
+//     then each column at its offset in little endian. Offsets are
+//     aligned to the field size, records to 8 bytes
+//   STRING, GEOMETRY and BLOB fields: uint32 offset from the heap start
+//     and uint32 byte length of the value in the heap. Strings are UTF-8
+//     without terminator
+//   BOOL: 1 byte, TIMESTAMP: int64 milliseconds
+// Array columns are not supported
+class PackedLayout {
+ public:
+    explicit PackedLayout(const ContainerSchema &schema);
+
+    // First column of unsupported type, -1 if all columns are supported
+    int unsupportedColumn() const;
+    size_t recordSize() const;
+    // Object describing the layout for packedLayout()
+    Napi::Value toObject(const Napi::Env &env) const;
+
+    // Set fields of row from record rowNo of data. Return NULL on success
+    // or error message. *ret is set to result of the failed C-API call or
+    // GS_RESULT_OK for malformed data
+    const char* readRecord(const uint8_t *data, size_t size,
+            size_t rowCount, size_t rowNo, GSRow *row, GSResult *ret,
+            std::string *buffer) const;
+
+ private:
+    struct Column {
+        std::string name;
+        GSType type;
+        size_t offset;
+        size_t size;
+    };
+    std::vector<Column> mColumnList;
+    size_t mBitmapSize;
+    size_t mRecordSize;
+    int mUnsupportedColumn;
+
+    // Bytes of field in a record, 0 for unsupported type
+    static size_t fieldSize(GSType type);
+};
+
+}  // namespace griddb
+
+#endif  // PACKEDLAYOUT_H
@@ -0,0 +1,175 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <chrono>
+#include "PartitionCache.h"
+
+namespace griddb {
+
+PartitionCache::PartitionCache(std::shared_ptr<StorePool> pool) :
+        mPool(pool), mStore(NULL), mController(NULL) {
+}
+
+PartitionCache::~PartitionCache() {
+    close();
+}
+
+void PartitionCache::close() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mController != NULL) {
+            gsClosePartitionController(&mController);
+        }
+        mPool->release(mStore);
+        mStore = NULL;
+    }
+    std::lock_guard<std::mutex> lock(mTopologyMutex);
+    mTopology.reset();
+}
+
+/**
+ * @brief Get partition controller, created at first use. mMutex must be held.
+ */
+GSResult PartitionCache::controller(GSPartitionController **controller) {
+    GSResult ret = GS_RESULT_OK;
+    if (mStore == NULL) {
+        ret = mPool->acquire(&mStore);
+        if (!GS_SUCCEEDED(ret)) {
+            return ret;
+        }
+    }
+    if (mController == NULL) {
+        ret = gsGetPartitionController(mStore, &mController);
+    }
+    *controller = mController;
+    return ret;
+}
+
+/**
+ * @brief Get partition index of container. Each name is resolved once.
+ * @param *containerName Container name
+ * @param *index A pointer stores partition index
+ * @return Result of C-API
+ */
+GSResult PartitionCache::getPartitionIndex(const GSChar *containerName,
+        int32_t *index) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::unordered_map<std::string, int32_t>::iterator it =
+            mIndexMap.find(containerName);
+    if (it != mIndexMap.end()) {
+        *index = it->second;
+        return GS_RESULT_OK;
+    }
+    GSPartitionController *partitionController;
+    GSResult ret = controller(&partitionController);
+    if (!GS_SUCCEEDED(ret)) {
+        return ret;
+    }
+    ret = gsGetPartitionIndexOfContainer(partitionController, containerName,
+            index);
+    if (!GS_SUCCEEDED(ret)) {
+        return ret;
+    }
+    if (mIndexMap.size() >= PARTITION_CACHE_MAX_ENTRIES) {
+        mIndexMap.clear();
+    }
+    mIndexMap[containerName] = *index;
+    return GS_RESULT_OK;
+}
+
+int64_t PartitionCache::now() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Get cached topology if it is not older than refreshInterval.
+ * @param refreshInterval Max age of snapshot in milliseconds
+ * @return Cached snapshot, or empty pointer when it should be refreshed
+ */
+std::shared_ptr<const PartitionTopology> PartitionCache::getTopology(
+        int64_t refreshInterval) {
+    std::lock_guard<std::mutex> lock(mTopologyMutex);
+    if (mTopology && now() - mTopology->updatedTime <= refreshInterval) {
+        return mTopology;
+    }
+    return std::shared_ptr<const PartitionTopology>();
+}
+
+/**
+ * @brief Read hosts of all partitions and replace cached snapshot.
+ *   Uses its own pooled handle, so may be called from worker thread
+ *   without blocking getPartitionIndex().
+ * @param *error Stores error when C-API fails
+ * @return New snapshot, or empty pointer on error
+ */
+std::shared_ptr<const PartitionTopology> PartitionCache::refreshTopology(
+        GSErrorDetail *error) {
+    std::shared_ptr<PartitionTopology> topology(new PartitionTopology());
+    GSGridStore *store;
+    GSResult ret = mPool->acquire(&store);
+    if (!GS_SUCCEEDED(ret)) {
+        error->capture(ret, NULL);
+        return std::shared_ptr<const PartitionTopology>();
+    }
+    GSPartitionController *partitionController = NULL;
+    int32_t partitionCount = 0;
+    ret = gsGetPartitionController(store, &partitionController);
+    if (GS_SUCCEEDED(ret)) {
+        ret = gsGetPartitionCount(partitionController, &partitionCount);
+    }
+    for (int32_t i = 0; GS_SUCCEEDED(ret) && i < partitionCount; i++) {
+        PartitionHosts hosts;
+        const GSChar *owner = NULL;
+        ret = gsGetPartitionOwnerHost(partitionController, i, &owner);
+        if (!GS_SUCCEEDED(ret)) {
+            break;
+        }
+        if (owner != NULL) {
+            hosts.owner = owner;
+        }
+        const GSChar *const *addressList;
+        size_t size;
+        ret = gsGetPartitionBackupHosts(partitionController, i,
+                &addressList, &size);
+        if (!GS_SUCCEEDED(ret)) {
+            break;
+        }
+        for (size_t j = 0; j < size; j++) {
+            hosts.backupList.push_back(addressList[j]);
+        }
+        topology->partitionList.push_back(hosts);
+    }
+    if (!GS_SUCCEEDED(ret)) {
+        error->capture(ret, partitionController != NULL ?
+                static_cast<void*>(partitionController) :
+                static_cast<void*>(store));
+    }
+    if (partitionController != NULL) {
+        gsClosePartitionController(&partitionController);
+    }
+    mPool->release(store);
+    if (error->failed()) {
+        return std::shared_ptr<const PartitionTopology>();
+    }
+
+    topology->updatedTime = now();
+    std::lock_guard<std::mutex> lock(mTopologyMutex);
+    mTopology = topology;
+    return mTopology;
+}
+
+}  // namespace griddb
@@ -0,0 +1,76 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef PARTITIONCACHE_H
+#define PARTITIONCACHE_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "gridstore.h"
+#include "GSException.h"
+#include "StorePool.h"
+
+#define PARTITION_CACHE_MAX_ENTRIES 100000
+#define DEFAULT_TOPOLOGY_REFRESH_INTERVAL 60000  // milliseconds
+
+namespace griddb {
+
+// Owner and backup hosts of one partition
+struct PartitionHosts {
+    std::string owner;
+    std::vector<std::string> backupList;
+};
+
+// Hosts of all partitions, taken at updatedTime
+struct PartitionTopology {
+    int64_t updatedTime;  // milliseconds, steady clock
+    std::vector<PartitionHosts> partitionList;
+};
+
+// Container name to partition index map shared by one Store.
+// Uses its own pooled handle so that it can be called from worker threads.
+class PartitionCache {
+ public:
+    explicit PartitionCache(std::shared_ptr<StorePool> pool);
+    ~PartitionCache();
+
+    GSResult getPartitionIndex(const GSChar *containerName, int32_t *index);
+    std::shared_ptr<const PartitionTopology> getTopology(
+            int64_t refreshInterval);
+    std::shared_ptr<const PartitionTopology> refreshTopology(
+            GSErrorDetail *error);
+    static int64_t now();
+    // Release the handle and drop cached topology, for Store.close()
+    void close();
+
+ private:
+    std::shared_ptr<StorePool> mPool;
+    std::shared_ptr<const PartitionTopology> mTopology;
+    std::mutex mTopologyMutex;
+    GSGridStore *mStore;
+    GSPartitionController *mController;
+    std::unordered_map<std::string, int32_t> mIndexMap;
+    std::mutex mMutex;
+
+    GSResult controller(GSPartitionController **controller);
+};
+
+}  // namespace griddb
+
+#endif  // PARTITIONCACHE_H
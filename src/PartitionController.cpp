@@ -16,6 +16,7 @@
 
 #include <string>
 #include "PartitionController.h"
+#include "Watchdog.h"
 
 namespace griddb {
 
@@ -35,7 +36,18 @@ Napi::Object PartitionController::init(Napi::Env env, Napi::Object exports) {
                             &PartitionController::getPartitionCount,
                             &PartitionController::setReadonlyAttribute),
                     InstanceMethod("getContainerNames",
-                            &PartitionController::getContainerNames)
+                            &PartitionController::getContainerNames),
+                    InstanceMethod("getPartitionHosts",
+                            &PartitionController::getPartitionHosts),
+                    InstanceMethod("getPartitionOwnerHost",
+                            &PartitionController::getPartitionOwnerHost),
+                    InstanceMethod("getPartitionBackupHosts",
+                            &PartitionController::getPartitionBackupHosts),
+                    InstanceMethod("assignPartitionPreferableHost",
+                            &PartitionController::
+                                    assignPartitionPreferableHost),
+                    InstanceMethod("getTopology",
+                            &PartitionController::getTopology)
             });
 
 #if NAPI_VERSION > 5
@@ -53,7 +65,8 @@ Napi::Object PartitionController::init(Napi::Env env, Napi::Object exports) {
 PartitionController::PartitionController(const Napi::CallbackInfo &info) :
         Napi::ObjectWrap<PartitionController>(info) {
     Napi::Env env = info.Env();
-    if (info.Length() != 1 || !info[0].IsExternal()) {
+    if (info.Length() < 1 || info.Length() > 2 || !info[0].IsExternal()
+            || (info.Length() == 2 && !info[1].IsExternal())) {
         // Throw error
         THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", mController)
         return;
@@ -61,6 +74,11 @@ PartitionController::PartitionController(const Napi::CallbackInfo &info) :
 
     this->mController =
             info[0].As<Napi::External<GSPartitionController>>().Data();
+    if (info.Length() == 2) {
+        // Partition cache shared with the owner Store
+        mCache = *info[1].As<Napi::External<
+                std::shared_ptr<PartitionCache> >>().Data();
+    }
 }
 
 PartitionController::~PartitionController() {
@@ -73,6 +91,7 @@ PartitionController::~PartitionController() {
 Napi::Value PartitionController::getContainerCount(
         const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("PartitionController.getContainerCount", info);
     int32_t partition_index = info[0].As<Napi::Number>().Int32Value();
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
 
@@ -94,6 +113,8 @@ Napi::Value PartitionController::getContainerCount(
 Napi::Value PartitionController::getPartitionIndexOfContainer(
         const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("PartitionController.getPartitionIndexOfContainer",
+            info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
     if (info.Length() != 1 || !info[0].IsString()) {
         // Throw error
@@ -121,6 +142,7 @@ Napi::Value PartitionController::getPartitionIndexOfContainer(
 Napi::Value PartitionController::getPartitionCount(
         const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("PartitionController.partitionCount", info);
 
     int32_t value;
     GSResult ret = gsGetPartitionCount(mController, &value);
@@ -145,6 +167,7 @@ void PartitionController::setReadonlyAttribute(const Napi::CallbackInfo &info,
 Napi::Value PartitionController::getContainerNames(
         const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("PartitionController.getContainerNames", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
     if (info.Length() != 3 || !info[0].IsNumber()|| !info[1].IsNumber()
             || !info[2].IsNumber()) {
@@ -180,5 +203,197 @@ Napi::Value PartitionController::getContainerNames(
     return deferred.Promise();
 }
 
-}  // namespace griddb
+static Napi::Array toStringArray(Napi::Env env,
+        const GSChar *const *stringList, size_t size) {
+    Napi::Array array = Napi::Array::New(env, size);
+    for (int i = 0; i < static_cast<int>(size); i++) {
+        array.Set(i, Napi::String::New(env, stringList[i]));
+    }
+    return array;
+}
+
+Napi::Value PartitionController::getPartitionHosts(
+        const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("PartitionController.getPartitionHosts", info);
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    if (info.Length() != 1 || !info[0].IsNumber()) {
+        // Throw error
+        PROMISE_REJECT_WITH_STRING(
+                deferred, env, "Wrong arguments", mController)
+    }
+    int32_t partitionIndex = info[0].As<Napi::Number>().Int32Value();
+    const GSChar *const *addressList;
+    size_t size;
+    GSResult ret = gsGetPartitionHosts(mController, partitionIndex,
+            &addressList, &size);
+    if (!GS_SUCCEEDED(ret)) {
+        PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, mController)
+    }
+    deferred.Resolve(toStringArray(env, addressList, size));
+    return deferred.Promise();
+}
+
+Napi::Value PartitionController::getPartitionOwnerHost(
+        const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("PartitionController.getPartitionOwnerHost", info);
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    if (info.Length() != 1 || !info[0].IsNumber()) {
+        // Throw error
+        PROMISE_REJECT_WITH_STRING(
+                deferred, env, "Wrong arguments", mController)
+    }
+    int32_t partitionIndex = info[0].As<Napi::Number>().Int32Value();
+    const GSChar *address = NULL;
+    GSResult ret = gsGetPartitionOwnerHost(mController, partitionIndex,
+            &address);
+    if (!GS_SUCCEEDED(ret)) {
+        PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, mController)
+    }
+    if (address == NULL) {
+        deferred.Resolve(env.Null());
+    } else {
+        deferred.Resolve(Napi::String::New(env, address));
+    }
+    return deferred.Promise();
+}
 
+Napi::Value PartitionController::getPartitionBackupHosts(
+        const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("PartitionController.getPartitionBackupHosts", info);
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    if (info.Length() != 1 || !info[0].IsNumber()) {
+        // Throw error
+        PROMISE_REJECT_WITH_STRING(
+                deferred, env, "Wrong arguments", mController)
+    }
+    int32_t partitionIndex = info[0].As<Napi::Number>().Int32Value();
+    const GSChar *const *addressList;
+    size_t size;
+    GSResult ret = gsGetPartitionBackupHosts(mController, partitionIndex,
+            &addressList, &size);
+    if (!GS_SUCCEEDED(ret)) {
+        PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, mController)
+    }
+    deferred.Resolve(toStringArray(env, addressList, size));
+    return deferred.Promise();
+}
+
+/**
+ * Set host preferred for reading the partition, or null to reset it.
+ * Affects only the Store which this controller was got from.
+ */
+Napi::Value PartitionController::assignPartitionPreferableHost(
+        const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("PartitionController.assignPartitionPreferableHost",
+            info);
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    if (info.Length() != 2 || !info[0].IsNumber()
+            || !(info[1].IsString() || info[1].IsNull())) {
+        // Throw error
+        PROMISE_REJECT_WITH_STRING(
+                deferred, env, "Wrong arguments", mController)
+    }
+    int32_t partitionIndex = info[0].As<Napi::Number>().Int32Value();
+    std::string host;
+    if (info[1].IsString()) {
+        host = info[1].As<Napi::String>().Utf8Value();
+    }
+    GSResult ret = gsAssignPartitionPreferableHost(mController,
+            partitionIndex, info[1].IsString() ? host.c_str() : NULL);
+    if (!GS_SUCCEEDED(ret)) {
+        PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, mController)
+    }
+    deferred.Resolve(env.Null());
+    return deferred.Promise();
+}
+
+static Napi::Array toTopologyArray(Napi::Env env,
+        std::shared_ptr<const PartitionTopology> topology) {
+    const std::vector<PartitionHosts> &list = topology->partitionList;
+    Napi::Array array = Napi::Array::New(env, list.size());
+    for (int i = 0; i < static_cast<int>(list.size()); i++) {
+        Napi::Object hosts = Napi::Object::New(env);
+        hosts.Set("owner", list[i].owner.empty() ? env.Null() :
+                Napi::String::New(env, list[i].owner));
+        Napi::Array backups = Napi::Array::New(env,
+                list[i].backupList.size());
+        for (int j = 0; j < static_cast<int>(list[i].backupList.size());
+                j++) {
+            backups.Set(j, Napi::String::New(env,
+                    list[i].backupList[j]));
+        }
+        hosts.Set("backups", backups);
+        array.Set(i, hosts);
+    }
+    return array;
+}
+
+// Read hosts of all partitions off the JS thread
+class TopologyWorker : public Napi::AsyncWorker {
+ public:
+    TopologyWorker(Napi::Env env, Napi::Promise::Deferred deferred,
+            std::shared_ptr<PartitionCache> cache) :
+            Napi::AsyncWorker(env), mDeferred(deferred), mCache(cache) {
+    }
+
+ protected:
+    void Execute() override {
+        mTopology = mCache->refreshTopology(&mError);
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        if (mError.failed()) {
+            Napi::Object obj = GSException::New(env, mError);
+            mDeferred.Reject(Napi::Error(env, obj).Value());
+            return;
+        }
+        mDeferred.Resolve(toTopologyArray(env, mTopology));
+    }
+
+ private:
+    Napi::Promise::Deferred mDeferred;
+    std::shared_ptr<PartitionCache> mCache;
+    std::shared_ptr<const PartitionTopology> mTopology;
+    GSErrorDetail mError;
+};
+
+/**
+ * Get owner and backup hosts of all partitions, indexed by partition.
+ * The snapshot is cached by the Store and read again only when it is
+ * older than refreshInterval milliseconds.
+ */
+Napi::Value PartitionController::getTopology(
+        const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("PartitionController.getTopology", info);
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    if (info.Length() > 1 || (info.Length() == 1 && !info[0].IsNumber())) {
+        // Throw error
+        PROMISE_REJECT_WITH_STRING(
+                deferred, env, "Wrong arguments", mController)
+    }
+    if (!mCache) {
+        PROMISE_REJECT_WITH_STRING(
+                deferred, env, "Topology cache is not available", mController)
+    }
+    int64_t refreshInterval = DEFAULT_TOPOLOGY_REFRESH_INTERVAL;
+    if (info.Length() == 1) {
+        refreshInterval = info[0].As<Napi::Number>().Int64Value();
+    }
+    std::shared_ptr<const PartitionTopology> topology =
+            mCache->getTopology(refreshInterval);
+    if (topology) {
+        deferred.Resolve(toTopologyArray(env, topology));
+        return deferred.Promise();
+    }
+    TopologyWorker *worker = new TopologyWorker(env, deferred, mCache);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+}  // namespace griddb
@@ -18,6 +18,8 @@
 #define PARTITIONCONTROLLER_H
 
 #include <napi.h>
+#include <memory>
+#include "PartitionCache.h"
 #include "Util.h"
 #include "Macro.h"
 
@@ -40,6 +42,11 @@ class PartitionController: public Napi::ObjectWrap<PartitionController> {
     Napi::Value getPartitionIndexOfContainer(const Napi::CallbackInfo &info);
     Napi::Value getPartitionCount(const Napi::CallbackInfo &info);
     Napi::Value getContainerNames(const Napi::CallbackInfo &info);
+    Napi::Value getPartitionHosts(const Napi::CallbackInfo &info);
+    Napi::Value getPartitionOwnerHost(const Napi::CallbackInfo &info);
+    Napi::Value getPartitionBackupHosts(const Napi::CallbackInfo &info);
+    Napi::Value assignPartitionPreferableHost(const Napi::CallbackInfo &info);
+    Napi::Value getTopology(const Napi::CallbackInfo &info);
 
     // N-API support method
     void setReadonlyAttribute(const Napi::CallbackInfo &info,
@@ -47,6 +54,7 @@ class PartitionController: public Napi::ObjectWrap<PartitionController> {
 
  private:
     GSPartitionController *mController;
+    std::shared_ptr<PartitionCache> mCache;
 };
 
 }  // namespace griddb
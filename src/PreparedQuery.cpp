@@ -0,0 +1,96 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "PreparedQuery.h"
+#include <string>
+#include "Watchdog.h"
+
+namespace griddb {
+
+#if NAPI_VERSION <= 5
+Napi::FunctionReference PreparedQuery::constructor;
+#endif
+
+Napi::Object PreparedQuery::init(Napi::Env env, Napi::Object exports) {
+    Napi::HandleScope scope(env);
+
+    Napi::Function func = DefineClass(env, "PreparedQuery",
+            { InstanceMethod("query", &PreparedQuery::query),
+              InstanceAccessor("parameterCount",
+                      &PreparedQuery::getParameterCount, nullptr)
+            });
+
+#if NAPI_VERSION > 5
+    Napi::FunctionReference* constructor = new Napi::FunctionReference();
+    *constructor = Napi::Persistent(func);
+    Util::setInstanceData(env, "PreparedQuery", constructor);
+#else
+    constructor = Napi::Persistent(func);
+    constructor.SuppressDestruct();
+#endif
+    exports.Set("PreparedQuery", func);
+    return exports;
+}
+
+PreparedQuery::PreparedQuery(const Napi::CallbackInfo &info) :
+        Napi::ObjectWrap<PreparedQuery>(info) {
+    Napi::Env env = info.Env();
+    if (info.Length() != 2 || !info[0].IsObject() || !info[1].IsExternal()) {
+        // Throw error
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
+        return;
+    }
+    // Keep container alive while this object is used
+    mContainer = Napi::Persistent(info[0].As<Napi::Object>());
+    mTemplate = *info[1].As<Napi::External<
+            std::shared_ptr<const QueryTemplate> >>().Data();
+}
+
+/**
+ * @brief Create Query with parameters bound to "?" of template
+ * @param info[0] Array of parameters: number, string, boolean, Date,
+ *   bigint or null. May be omitted if template has no parameter
+ * @return Query object
+ */
+Napi::Value PreparedQuery::query(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("PreparedQuery.query", info);
+    if (info.Length() > 1 || (info.Length() == 1 && !info[0].IsArray())) {
+        // Throw error
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
+        return env.Null();
+    }
+    Napi::Array params = info.Length() == 1 ?
+            info[0].As<Napi::Array>() : Napi::Array::New(env);
+    std::string tql;
+    try {
+        tql = mTemplate->render(env, params);
+    } catch (const Napi::Error &e) {
+        e.ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Container *container =
+            Napi::ObjectWrap<Container>::Unwrap(mContainer.Value());
+    return container->newQuery(env, tql);
+}
+
+Napi::Value PreparedQuery::getParameterCount(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    return Napi::Number::New(env,
+            static_cast<double>(mTemplate->parameterCount()));
+}
+
+}  // namespace griddb
@@ -0,0 +1,50 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef PREPAREDQUERY_H
+#define PREPAREDQUERY_H
+
+#include <napi.h>
+#include <memory>
+#include "Container.h"
+#include "QueryTemplate.h"
+#include "Util.h"
+#include "Macro.h"
+
+namespace griddb {
+
+class PreparedQuery: public Napi::ObjectWrap<PreparedQuery> {
+ public:
+#if NAPI_VERSION <= 5
+    // Constructor static variable
+    static Napi::FunctionReference constructor;
+#endif
+    static Napi::Object init(Napi::Env env, Napi::Object exports);
+
+    explicit PreparedQuery(const Napi::CallbackInfo &info);
+
+    // N-API methods
+    Napi::Value query(const Napi::CallbackInfo &info);
+    Napi::Value getParameterCount(const Napi::CallbackInfo &info);
+
+ private:
+    Napi::ObjectReference mContainer;
+    std::shared_ptr<const QueryTemplate> mTemplate;
+};
+
+}  // namespace griddb
+
+#endif  // PREPAREDQUERY_H
@@ -15,6 +15,10 @@
 */
 
 #include "Query.h"
+#include <vector>
+#include "Metrics.h"
+#include "Tracing.h"
+#include "Watchdog.h"
 
 namespace griddb {
 
@@ -29,6 +33,7 @@ Napi::Object Query::init(Napi::Env env, Napi::Object exports) {
             { InstanceMethod("fetch", &Query::fetch),
               InstanceMethod("setFetchOptions", &Query::setFetchOptions),
               InstanceMethod("getRowSet", &Query::getRowSet),
+              InstanceMethod("close", &Query::close),
             });
 
 #if NAPI_VERSION > 5
@@ -44,27 +49,62 @@ Napi::Object Query::init(Napi::Env env, Napi::Object exports) {
 }
 
 Query::Query(const Napi::CallbackInfo &info) :
-        Napi::ObjectWrap<Query>(info) {
+        Napi::ObjectWrap<Query>(info), mQuery(NULL) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
-    if (info.Length() != 3 || !info[0].IsExternal() || !info[1].IsExternal()
-            || !info[2].IsExternal()) {
+    if ((info.Length() != 3 && info.Length() != 4) || !info[0].IsExternal()
+            || !info[1].IsExternal() || !info[2].IsExternal()
+            || (info.Length() == 4 && !info[3].IsString())) {
         // Throw error
         THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
         return;
     }
     this->mQuery = info[0].As<Napi::External<GSQuery>>().Data();
-    this->mContainerInfo = info[1].As<Napi::External<GSContainerInfo>>().Data();
-    this->mRow = info[2].As<Napi::External<GSRow>>().Data();
+    Metrics::addGauge(GAUGE_OPEN_QUERIES, 1);
+    this->mSchema = info[1].As<Napi::External<ContainerSchema>>().Data()->
+            shared_from_this();
+    this->mRowPool = *info[2].As<Napi::External<
+            std::shared_ptr<RowPool> >>().Data();
+    if (info.Length() == 4) {
+        this->mContainerName = info[3].As<Napi::String>().Utf8Value();
+    }
 }
 
+/**
+ * @brief Execute query
+ * @param info[0] Optional options object.
+ *   columns: array of column names or numbers, RowSet.next returns only
+ *   these columns
+ * @return Promise of RowSet object
+ */
 Napi::Value Query::fetch(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Query.fetch", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    PhaseTimer timer(CALL_QUERY_FETCH);
+    TraceSpan span("griddb.Query.fetch");
+    span.setContainer(mContainerName);
+    std::vector<int> projection;
+    bool projected = false;
+    if (info.Length() > 0) {
+        try {
+            projected = mSchema->toProjectionOption(env, info[0],
+                    &projection);
+        } catch (const Napi::Error &e) {
+            PROMISE_REJECT_WITH_ERROR(deferred, e)
+        }
+    }
     GSRowSet *gsRowSet;
     // Call method from C-Api.
     GSBool gsForUpdate = GS_FALSE;
+    timer.enter(PHASE_EXECUTE);
+    int64_t startTime = Metrics::begin();
     GSResult ret = gsFetch(mQuery, gsForUpdate, &gsRowSet);
+    Metrics::record(METRIC_FETCH, mSchema->containerType(), startTime, ret);
+    span.setResult(ret);
+    if (GS_SUCCEEDED(ret) && span.active()) {
+        span.setRows(gsGetRowSetSize(gsRowSet));
+    }
 
     // Check ret, if error, throw exception
     if (!GS_SUCCEEDED(ret)) {
@@ -72,30 +112,39 @@ Napi::Value Query::fetch(const Napi::CallbackInfo &info) {
     }
 
     // Create new RowSet object
-    Napi::EscapableHandleScope scope(env);
-    auto rowsetPtr = Napi::External<GSRowSet>::New(env, gsRowSet);
-    auto gsContainerInfoPtr =
-            Napi::External<GSContainerInfo>::New(env, mContainerInfo);
-    auto gsRowPtr = Napi::External<GSRow>::New(env, mRow);
-#if NAPI_VERSION > 5
-    Napi::Value rowsetWrapper = scope.Escape(
-            Util::getInstanceData(env, "RowSet")->New({
-                    rowsetPtr, gsContainerInfoPtr, gsRowPtr })).ToObject();
-#else
-    Napi::Value rowsetWrapper = scope.Escape(RowSet::constructor.New({
-            rowsetPtr, gsContainerInfoPtr, gsRowPtr })).ToObject();
-#endif
+    timer.enter(PHASE_BUILD);
+    Napi::Value rowsetWrapper = newRowSet(env, gsRowSet,
+            projected ? &projection : NULL);
+    if (rowsetWrapper.IsNull()) {
+        PROMISE_REJECT_WITH_STRING(deferred, env,
+                "Can't create row of container", mQuery)
+    }
     deferred.Resolve(rowsetWrapper);
+    timer.finish(deferred.Promise());
     return deferred.Promise();
 }
 
 Query::~Query() {
+    release();
+}
+
+void Query::release() {
     if (mQuery) {
         gsCloseQuery(&mQuery);
         mQuery = NULL;
+        Metrics::addGauge(GAUGE_OPEN_QUERIES, -1);
     }
 }
 
+/**
+ * @brief Close the query handle now instead of on GC. Calling again does
+ *   nothing
+ */
+Napi::Value Query::close(const Napi::CallbackInfo &info) {
+    release();
+    return info.Env().Undefined();
+}
+
 void Query::setFetchOptions(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
 
@@ -141,17 +190,47 @@ Napi::Value Query::getRowSet(const Napi::CallbackInfo &info) {
         THROW_EXCEPTION_WITH_CODE(env, ret, mQuery)
         return env.Null();
     }
-    auto rowset_ptr = Napi::External<GSRowSet>::New(env, gsRowSet);
-    auto containerInfo_ptr = Napi::External<GSContainerInfo>
-                ::New(env, mContainerInfo);
-    auto row_ptr = Napi::External<GSRow>::New(env, mRow);
+    Napi::Value rowsetWrapper = newRowSet(env, gsRowSet, NULL);
+    if (rowsetWrapper.IsNull()) {
+        THROW_EXCEPTION_WITH_STR(env, "Can't create row of container", mQuery)
+        return env.Null();
+    }
+    return rowsetWrapper;
+}
+
+/**
+ * @brief Wrap gsRowSet into a RowSet object reading into its own row, so
+ *   RowSets of the same container do not overwrite rows of each other.
+ *   gsRowSet is closed when no row can be acquired
+ * @param *gsRowSet Row set owned by the new object
+ * @param *projection Columns option of fetch, may be NULL
+ * @return RowSet object or null
+ */
+Napi::Value Query::newRowSet(const Napi::Env &env, GSRowSet *gsRowSet,
+        const std::vector<int> *projection) {
+    GSRow *row = mRowPool->acquire();
+    if (row == NULL) {
+        gsCloseRowSet(&gsRowSet);
+        return env.Null();
+    }
     Napi::EscapableHandleScope scope(env);
+    auto rowsetPtr = Napi::External<GSRowSet>::New(env, gsRowSet);
+    auto schemaPtr = Napi::External<ContainerSchema>::New(env,
+            const_cast<ContainerSchema*>(mSchema.get()));
+    auto gsRowPtr = Napi::External<GSRow>::New(env, row);
+    auto rowPoolPtr = Napi::External<std::shared_ptr<RowPool> >::New(env,
+            &mRowPool);
+    std::vector<napi_value> args = {rowsetPtr, schemaPtr, gsRowPtr,
+            rowPoolPtr};
+    if (projection) {
+        args.push_back(Napi::External<std::vector<int> >::New(env,
+                const_cast<std::vector<int>*>(projection)));
+    }
 #if NAPI_VERSION > 5
-    return scope.Escape(Util::getInstanceData(env, "RowSet")->New({
-            rowset_ptr, containerInfo_ptr, row_ptr })).ToObject();
+    return scope.Escape(
+            Util::getInstanceData(env, "RowSet")->New(args)).ToObject();
 #else
-    return scope.Escape(RowSet::constructor.New({
-            rowset_ptr, containerInfo_ptr, row_ptr })).ToObject();
+    return scope.Escape(RowSet::constructor.New(args)).ToObject();
 #endif
 }
 
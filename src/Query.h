@@ -18,7 +18,12 @@
 #define QUERY_H
 
 #include <napi.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ContainerSchema.h"
 #include "Util.h"
+#include "RowPool.h"
 #include "RowSet.h"
 #include "Macro.h"
 
@@ -39,11 +44,21 @@ class Query: public Napi::ObjectWrap<Query> {
     Napi::Value fetch(const Napi::CallbackInfo &info);
     void setFetchOptions(const Napi::CallbackInfo &info);
     Napi::Value getRowSet(const Napi::CallbackInfo &info);
+    Napi::Value close(const Napi::CallbackInfo &info);
     GSQuery* gsPtr();
  private:
     GSQuery *mQuery;
-    GSContainerInfo *mContainerInfo;
-    GSRow* mRow;
+    std::shared_ptr<const ContainerSchema> mSchema;
+    // Rows of RowSets, shared with the container
+    std::shared_ptr<RowPool> mRowPool;
+    std::string mContainerName;
+
+    // Create RowSet object owning gsRowSet and a row of mRowPool
+    Napi::Value newRowSet(const Napi::Env &env, GSRowSet *gsRowSet,
+            const std::vector<int> *projection);
+
+    // Close query handle, can be called more than once
+    void release();
 };
 
 }  // namespace griddb
@@ -0,0 +1,161 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "QueryTemplate.h"
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include "GSException.h"
+#include "Macro.h"
+
+namespace griddb {
+
+QueryTemplate::QueryTemplate(const std::string &tql) {
+    std::string part;
+    char quote = 0;
+    for (size_t i = 0; i < tql.size(); i++) {
+        char c = tql[i];
+        if (quote) {
+            // Doubled quote closes and opens again, so no special case
+            if (c == quote) {
+                quote = 0;
+            }
+        } else if (c == '\'' || c == '"') {
+            quote = c;
+        } else if (c == '?') {
+            mPartList.push_back(part);
+            part.clear();
+            continue;
+        }
+        part.push_back(c);
+    }
+    mPartList.push_back(part);
+}
+
+size_t QueryTemplate::parameterCount() const {
+    return mPartList.size() - 1;
+}
+
+/**
+ * @brief Make TQL from template and parameters
+ * @param env Napi env
+ * @param params Parameter values, one for each "?"
+ * @return TQL string
+ */
+std::string QueryTemplate::render(const Napi::Env &env,
+        const Napi::Array &params) const {
+    if (params.Length() != parameterCount()) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Wrong number of parameters")
+    }
+    std::string tql;
+    size_t size = 0;
+    for (size_t i = 0; i < mPartList.size(); i++) {
+        size += mPartList[i].size() + 16;
+    }
+    tql.reserve(size);
+    tql.append(mPartList[0]);
+    for (uint32_t i = 0; i < params.Length(); i++) {
+        appendLiteral(env, params[i], &tql);
+        tql.append(mPartList[i + 1]);
+    }
+    return tql;
+}
+
+/**
+ * @brief Append value as TQL literal. Strings are quoted with quotes
+ *   doubled, so parameter can not change the query
+ */
+void QueryTemplate::appendLiteral(const Napi::Env &env, Napi::Value value,
+        std::string *tql) {
+    char buffer[GS_TIME_STRING_SIZE_MAX + 16];
+    if (value.IsNull() || value.IsUndefined()) {
+        tql->append("NULL");
+    } else if (value.IsBoolean()) {
+        tql->append(value.As<Napi::Boolean>().Value() ? "TRUE" : "FALSE");
+    } else if (value.IsNumber()) {
+        double number = value.As<Napi::Number>().DoubleValue();
+        if (!std::isfinite(number)) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "Invalid parameter")
+        }
+        if (number == std::trunc(number) && std::fabs(number) < 9.0e15) {
+            snprintf(buffer, sizeof(buffer), "%" PRId64,
+                    static_cast<int64_t>(number));
+        } else {
+            snprintf(buffer, sizeof(buffer), "%.17g", number);
+        }
+        tql->append(buffer);
+    } else if (value.IsString()) {
+        std::string str = value.As<Napi::String>().Utf8Value();
+        tql->push_back('\'');
+        for (size_t i = 0; i < str.size(); i++) {
+            if (str[i] == '\'') {
+                tql->push_back('\'');
+            }
+            tql->push_back(str[i]);
+        }
+        tql->push_back('\'');
+#if (NAPI_VERSION > 4)
+    } else if (value.IsDate()) {
+        GSTimestamp timestamp = value.As<Napi::Date>().ValueOf();
+        if (gsFormatTime(timestamp, buffer, sizeof(buffer)) == 0) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "Invalid timestamp")
+        }
+        tql->append("TIMESTAMP('");
+        tql->append(buffer);
+        tql->append("')");
+#endif
+#if NAPI_VERSION > 5
+    } else if (value.IsBigInt()) {
+        bool lossless;
+        int64_t number = value.As<Napi::BigInt>().Int64Value(&lossless);
+        if (!lossless) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "Invalid parameter")
+        }
+        snprintf(buffer, sizeof(buffer), "%" PRId64, number);
+        tql->append(buffer);
+#endif
+    } else {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Not support parameter type")
+    }
+}
+
+QueryTemplateCache::QueryTemplateCache(size_t capacity) :
+        mCapacity(capacity) {
+}
+
+/**
+ * @brief Get parsed template of tql, parse it if not cached.
+ *   Least recently used template is removed when cache is full
+ */
+std::shared_ptr<const QueryTemplate> QueryTemplateCache::get(
+        const std::string &tql) {
+    auto it = mEntryMap.find(tql);
+    if (it != mEntryMap.end()) {
+        mEntryList.splice(mEntryList.begin(), mEntryList, it->second);
+        return it->second->second;
+    }
+    std::shared_ptr<const QueryTemplate> queryTemplate(
+            new QueryTemplate(tql));
+    mEntryList.push_front(std::make_pair(tql, queryTemplate));
+    mEntryMap[tql] = mEntryList.begin();
+    if (mEntryList.size() > mCapacity) {
+        mEntryMap.erase(mEntryList.back().first);
+        mEntryList.pop_back();
+    }
+    return queryTemplate;
+}
+
+}  // namespace griddb
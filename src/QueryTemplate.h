@@ -0,0 +1,68 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef QUERYTEMPLATE_H
+#define QUERYTEMPLATE_H
+
+#include <napi.h>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "gridstore.h"
+
+#define QUERY_TEMPLATE_CACHE_SIZE 64
+
+namespace griddb {
+
+// TQL with "?" parameters, split once into the parts between parameters.
+// "?" in quoted strings or names is not a parameter
+class QueryTemplate {
+ public:
+    explicit QueryTemplate(const std::string &tql);
+
+    size_t parameterCount() const;
+    // Make TQL with parameters as escaped literals. Throw Napi::Error
+    std::string render(const Napi::Env &env, const Napi::Array &params) const;
+
+ private:
+    std::vector<std::string> mPartList;
+
+    static void appendLiteral(const Napi::Env &env, Napi::Value value,
+            std::string *tql);
+};
+
+// Recently prepared templates of one container
+class QueryTemplateCache {
+ public:
+    explicit QueryTemplateCache(size_t capacity = QUERY_TEMPLATE_CACHE_SIZE);
+
+    std::shared_ptr<const QueryTemplate> get(const std::string &tql);
+
+ private:
+    typedef std::list<std::pair<std::string,
+            std::shared_ptr<const QueryTemplate> > > EntryList;
+
+    size_t mCapacity;
+    EntryList mEntryList;
+    std::unordered_map<std::string, EntryList::iterator> mEntryMap;
+};
+
+}  // namespace griddb
+
+#endif  // QUERYTEMPLATE_H
@@ -0,0 +1,188 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "RowCache.h"
+#include <string.h>
+#include <algorithm>
+#include <cctype>
+#include "ExternalMemory.h"
+#include "Metrics.h"
+#include "PartitionCache.h"
+
+namespace griddb {
+
+RowCache::RowCache(std::shared_ptr<MemoryAccount> account) :
+        mMaxBytes(0), mTtl(0), mBytes(0), mHits(0), mMisses(0),
+        mEvictions(0), mExpirations(0), mInvalidations(0), mEnabled(false),
+        mMemoryAccount(account) {
+}
+
+RowCache::~RowCache() {
+    for (EntryList::iterator it = mEntryList.begin(); it != mEntryList.end();
+            ++it) {
+        ExternalMemory::remove(mMemoryAccount.get(), MEMORY_ROW_CACHE,
+                it->bytes);
+    }
+}
+
+void RowCache::configure(size_t maxBytes, int64_t ttl) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMaxBytes = maxBytes;
+    mTtl = ttl;
+    mEnabled = maxBytes > 0;
+    while (mBytes > mMaxBytes && !mEntryList.empty()) {
+        erase(mIndex.find(mEntryList.back().key));
+        mEvictions++;
+        Metrics::add(COUNTER_ROW_CACHE_EVICTIONS, 1);
+    }
+}
+
+bool RowCache::enabled() const {
+    return mEnabled;
+}
+
+// Container names are case insensitive, and never contain NUL
+std::string RowCache::containerPrefix(const std::string &container) {
+    std::string prefix(container);
+    std::transform(prefix.begin(), prefix.end(), prefix.begin(),
+            [](unsigned char c) { return std::tolower(c); });
+    prefix.push_back('\0');
+    return prefix;
+}
+
+std::string RowCache::makeKey(const std::string &container, int64_t key) {
+    std::string result = containerPrefix(container);
+    result.append(reinterpret_cast<const char*>(&key), sizeof(key));
+    return result;
+}
+
+std::string RowCache::makeKey(const std::string &container,
+        const std::string &key) {
+    return containerPrefix(container) + key;
+}
+
+bool RowCache::get(const std::string &key, std::vector<FieldValue> *row) {
+    if (!mEnabled) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mIndex.find(key);
+    if (it == mIndex.end()) {
+        mMisses++;
+        Metrics::add(COUNTER_ROW_CACHE_MISSES, 1);
+        return false;
+    }
+    Entry &entry = *it->second;
+    if (mTtl > 0 && entry.expiryTime <= PartitionCache::now()) {
+        erase(it);
+        mExpirations++;
+        mMisses++;
+        Metrics::add(COUNTER_ROW_CACHE_MISSES, 1);
+        return false;
+    }
+    mEntryList.splice(mEntryList.begin(), mEntryList, it->second);
+    *row = entry.row;
+    mHits++;
+    Metrics::add(COUNTER_ROW_CACHE_HITS, 1);
+    return true;
+}
+
+void RowCache::put(const std::string &key,
+        const std::vector<FieldValue> &row) {
+    if (!mEnabled) {
+        return;
+    }
+    size_t bytes = sizeof(Entry) + key.size() * 2;
+    for (size_t i = 0; i < row.size(); i++) {
+        bytes += sizeof(FieldValue) + row[i].bytes.size();
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (bytes > mMaxBytes) {
+        return;
+    }
+    auto it = mIndex.find(key);
+    if (it != mIndex.end()) {
+        erase(it);
+    }
+    while (mBytes + bytes > mMaxBytes && !mEntryList.empty()) {
+        erase(mIndex.find(mEntryList.back().key));
+        mEvictions++;
+        Metrics::add(COUNTER_ROW_CACHE_EVICTIONS, 1);
+    }
+    Entry entry;
+    entry.key = key;
+    entry.row = row;
+    entry.bytes = bytes;
+    entry.expiryTime = mTtl > 0 ? PartitionCache::now() + mTtl : 0;
+    mEntryList.push_front(entry);
+    mIndex[key] = mEntryList.begin();
+    mBytes += bytes;
+    ExternalMemory::add(mMemoryAccount.get(), MEMORY_ROW_CACHE, bytes);
+}
+
+void RowCache::invalidate(const std::string &key) {
+    if (!mEnabled) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mIndex.find(key);
+    if (it != mIndex.end()) {
+        erase(it);
+        mInvalidations++;
+    }
+}
+
+void RowCache::invalidateContainer(const std::string &container) {
+    if (!mEnabled) {
+        return;
+    }
+    std::string prefix = containerPrefix(container);
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mIndex.lower_bound(prefix);
+    while (it != mIndex.end() &&
+            it->first.compare(0, prefix.size(), prefix) == 0) {
+        auto next = std::next(it);
+        erase(it);
+        mInvalidations++;
+        it = next;
+    }
+}
+
+RowCacheStats RowCache::stats() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    RowCacheStats result;
+    result.hits = mHits;
+    result.misses = mMisses;
+    result.evictions = mEvictions;
+    result.expirations = mExpirations;
+    result.invalidations = mInvalidations;
+    result.entries = mEntryList.size();
+    result.bytes = mBytes;
+    result.maxBytes = mMaxBytes;
+    result.ttl = mTtl;
+    return result;
+}
+
+void RowCache::erase(
+        std::map<std::string, EntryList::iterator>::iterator it) {
+    mBytes -= it->second->bytes;
+    ExternalMemory::remove(mMemoryAccount.get(), MEMORY_ROW_CACHE,
+            it->second->bytes);
+    mEntryList.erase(it->second);
+    mIndex.erase(it);
+}
+
+}  // namespace griddb
@@ -0,0 +1,102 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef ROWCACHE_H
+#define ROWCACHE_H
+
+#include <stdint.h>
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ExternalMemory.h"
+#include "FieldValue.h"
+
+namespace griddb {
+
+struct RowCacheStats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t expirations;
+    uint64_t invalidations;
+    size_t entries;
+    size_t bytes;
+    size_t maxBytes;
+    int64_t ttl;
+};
+
+// Read-through LRU cache of rows by (container, row key) shared by one
+// Store and its Containers. Disabled until configure() gives size cap.
+// Entries of a container are adjacent in the ordered index, so that all
+// of them can be invalidated at once
+class RowCache {
+ public:
+    explicit RowCache(std::shared_ptr<MemoryAccount> account);
+    ~RowCache();
+
+    // maxBytes 0 disables and clears the cache, ttl 0 keeps entries until
+    // evicted or invalidated. ttl is in milliseconds
+    void configure(size_t maxBytes, int64_t ttl);
+    bool enabled() const;
+
+    static std::string makeKey(const std::string &container, int64_t key);
+    static std::string makeKey(const std::string &container,
+            const std::string &key);
+
+    // Copy cached row, false on miss
+    bool get(const std::string &key, std::vector<FieldValue> *row);
+    void put(const std::string &key, const std::vector<FieldValue> &row);
+    void invalidate(const std::string &key);
+    void invalidateContainer(const std::string &container);
+    RowCacheStats stats();
+
+ private:
+    struct Entry {
+        std::string key;
+        std::vector<FieldValue> row;
+        size_t bytes;
+        int64_t expiryTime;
+    };
+    typedef std::list<Entry> EntryList;
+
+    // Most recently used first
+    EntryList mEntryList;
+    std::map<std::string, EntryList::iterator> mIndex;
+    size_t mMaxBytes;
+    int64_t mTtl;
+    size_t mBytes;
+    uint64_t mHits;
+    uint64_t mMisses;
+    uint64_t mEvictions;
+    uint64_t mExpirations;
+    uint64_t mInvalidations;
+    // Read without lock on fast path
+    std::atomic<bool> mEnabled;
+    // Rows are cached and evicted on worker threads
+    std::shared_ptr<MemoryAccount> mMemoryAccount;
+    std::mutex mMutex;
+
+    void erase(std::map<std::string, EntryList::iterator>::iterator it);
+    static std::string containerPrefix(const std::string &container);
+};
+
+}  // namespace griddb
+
+#endif  // ROWCACHE_H
@@ -0,0 +1,305 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "RowKeyList.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_set>
+#include "Util.h"
+#include "Macro.h"
+
+namespace griddb {
+
+RowKeyList::RowKeyList(GSType type) : mType(type) {
+}
+
+bool RowKeyList::isSupported(GSType type) {
+    return type == GS_TYPE_STRING || type == GS_TYPE_INTEGER ||
+            type == GS_TYPE_LONG || type == GS_TYPE_TIMESTAMP;
+}
+
+/**
+ * @brief Convert keys from JS. Array elements are converted like the key
+ *   of Container.get; TypedArray is accepted for numeric key types:
+ *   Int32Array, Float64Array and BigInt64Array.
+ * @param env Napi env
+ * @param value Array or TypedArray of keys
+ */
+void RowKeyList::fromValue(const Napi::Env &env, const Napi::Value &value) {
+    if (!isSupported(mType)) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Not support type")
+    }
+    if (value.IsTypedArray()) {
+        fromTypedArray(env, value.As<Napi::TypedArray>());
+        return;
+    }
+    if (!value.IsArray()) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Expected array of row keys")
+    }
+    Napi::Array array = value.As<Napi::Array>();
+    uint32_t length = array.Length();
+    if (mType == GS_TYPE_STRING) {
+        mStringList.reserve(length);
+        for (uint32_t i = 0; i < length; i++) {
+            Napi::Value key = array[i];
+            if (!key.IsString()) {
+                THROW_CPP_EXCEPTION_WITH_STR(env, "wrong type of rowKey string")
+            }
+            mStringList.push_back(key.As<Napi::String>().Utf8Value());
+        }
+        return;
+    }
+    mNumberList.reserve(length);
+    for (uint32_t i = 0; i < length; i++) {
+        mNumberList.push_back(toNumberKey(env, array[i]));
+    }
+}
+
+void RowKeyList::fromTypedArray(const Napi::Env &env,
+        const Napi::TypedArray &array) {
+    if (mType == GS_TYPE_STRING) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "wrong type of rowKey string")
+    }
+    size_t length = array.ElementLength();
+    mNumberList.resize(length);
+    switch (array.TypedArrayType()) {
+    case napi_int32_array: {
+        const int32_t *data = array.As<Napi::Int32Array>().Data();
+        std::copy(data, data + length, mNumberList.begin());
+        break;
+    }
+    case napi_float64_array: {
+        const double *data = array.As<Napi::Float64Array>().Data();
+        for (size_t i = 0; i < length; i++) {
+            if (!(data[i] >= -9.2233720368547758e18 &&
+                    data[i] < 9.2233720368547758e18) ||
+                    data[i] != std::trunc(data[i])) {
+                THROW_CPP_EXCEPTION_WITH_STR(env, "Invalid row key")
+            }
+            mNumberList[i] = checkRange(env, static_cast<int64_t>(data[i]));
+        }
+        break;
+    }
+#if NAPI_VERSION > 5
+    case napi_bigint64_array: {
+        const int64_t *data = array.As<Napi::BigInt64Array>().Data();
+        for (size_t i = 0; i < length; i++) {
+            mNumberList[i] = checkRange(env, data[i]);
+        }
+        break;
+    }
+#endif
+    default:
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Not support TypedArray for row key")
+    }
+}
+
+int64_t RowKeyList::toNumberKey(const Napi::Env &env,
+        Napi::Value value) const {
+#if NAPI_VERSION > 5
+    if (value.IsBigInt()) {
+        bool lossless;
+        int64_t key = value.As<Napi::BigInt>().Int64Value(&lossless);
+        if (!lossless) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "Invalid row key")
+        }
+        return checkRange(env, key);
+    }
+#endif
+    switch (mType) {
+    case GS_TYPE_INTEGER:
+        if (!value.IsNumber()) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "wrong type of rowKey integer")
+        }
+        return value.As<Napi::Number>().Int32Value();
+    case GS_TYPE_LONG:
+        if (!value.IsNumber()) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "wrong type of rowKey long")
+        }
+        return value.As<Napi::Number>().Int64Value();
+    default:
+        return Util::toGsTimestamp(env, &value);
+    }
+}
+
+int64_t RowKeyList::checkRange(const Napi::Env &env, int64_t key) const {
+    if (mType == GS_TYPE_INTEGER &&
+            (key < std::numeric_limits<int32_t>::min() ||
+            key > std::numeric_limits<int32_t>::max())) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Invalid row key")
+    }
+    return key;
+}
+
+/**
+ * @brief Convert STRING keys given as one buffer and offsets, to avoid
+ *   one JS string per key. Key i is bytes from offsets[i] to
+ *   offsets[i + 1] of buffer in UTF-8.
+ * @param env Napi env
+ * @param buffer Buffer or Uint8Array of concatenated keys
+ * @param offsets Uint32Array or Int32Array of key count + 1 offsets
+ */
+void RowKeyList::fromStringBuffer(const Napi::Env &env,
+        const Napi::Value &buffer, const Napi::Value &offsets) {
+    if (mType != GS_TYPE_STRING) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Not support type")
+    }
+    if (!buffer.IsTypedArray() || !offsets.IsTypedArray()) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Wrong arguments")
+    }
+    Napi::TypedArray data = buffer.As<Napi::TypedArray>();
+    Napi::TypedArray offsetArray = offsets.As<Napi::TypedArray>();
+    if (data.TypedArrayType() != napi_uint8_array ||
+            (offsetArray.TypedArrayType() != napi_uint32_array &&
+            offsetArray.TypedArrayType() != napi_int32_array)) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Wrong arguments")
+    }
+    const char *bytes =
+            reinterpret_cast<const char*>(data.As<Napi::Uint8Array>().Data());
+    size_t byteLength = data.ElementLength();
+    // Int32Array offsets are reinterpreted, negative ones fail range check
+    const uint32_t *offsetList = offsetArray.TypedArrayType() ==
+            napi_uint32_array ?
+            offsetArray.As<Napi::Uint32Array>().Data() :
+            reinterpret_cast<const uint32_t*>(
+                    offsetArray.As<Napi::Int32Array>().Data());
+    size_t offsetCount = offsetArray.ElementLength();
+    if (offsetCount == 0) {
+        return;
+    }
+    mStringList.reserve(offsetCount - 1);
+    for (size_t i = 0; i + 1 < offsetCount; i++) {
+        uint32_t start = offsetList[i];
+        uint32_t end = offsetList[i + 1];
+        if (start > end || end > byteLength) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "Invalid offsets of row keys")
+        }
+        mStringList.push_back(std::string(bytes + start, end - start));
+    }
+}
+
+GSResult RowKeyList::addKey(GSRowKeyPredicate *predicate, int64_t key) const {
+    switch (mType) {
+    case GS_TYPE_INTEGER:
+        return gsAddPredicateKeyByInteger(predicate,
+                static_cast<int32_t>(key));
+    case GS_TYPE_LONG:
+        return gsAddPredicateKeyByLong(predicate, key);
+    default:
+        return gsAddPredicateKeyByTimestamp(predicate, key);
+    }
+}
+
+/**
+ * @brief Add all keys to predicate in order.
+ *   Do not call N-API, can be called on worker thread.
+ * @param *predicate Predicate of the same key type
+ * @return Result of first failed gsAddPredicateKeyBy*()
+ */
+GSResult RowKeyList::addKeys(GSRowKeyPredicate *predicate) const {
+    GSResult ret = GS_RESULT_OK;
+    if (mType == GS_TYPE_STRING) {
+        for (size_t i = 0; i < mStringList.size() && GS_SUCCEEDED(ret); i++) {
+            ret = gsAddPredicateKeyByString(predicate,
+                    mStringList[i].c_str());
+        }
+        return ret;
+    }
+    for (size_t i = 0; i < mNumberList.size() && GS_SUCCEEDED(ret); i++) {
+        ret = addKey(predicate, mNumberList[i]);
+    }
+    return ret;
+}
+
+/**
+ * @brief Add each key to distinct key predicate once.
+ *   Do not call N-API, can be called on worker thread.
+ * @param *predicate Predicate of the same key type
+ * @return Result of first failed gsAddPredicateKeyBy*()
+ */
+GSResult RowKeyList::addDistinctKeys(GSRowKeyPredicate *predicate) const {
+    GSResult ret = GS_RESULT_OK;
+    if (mType == GS_TYPE_STRING) {
+        std::unordered_set<std::string> added;
+        for (size_t i = 0; i < mStringList.size() && GS_SUCCEEDED(ret); i++) {
+            if (added.insert(mStringList[i]).second) {
+                ret = gsAddPredicateKeyByString(predicate,
+                        mStringList[i].c_str());
+            }
+        }
+        return ret;
+    }
+    std::vector<int64_t> keyList(mNumberList);
+    std::sort(keyList.begin(), keyList.end());
+    keyList.erase(std::unique(keyList.begin(), keyList.end()), keyList.end());
+    for (size_t i = 0; i < keyList.size() && GS_SUCCEEDED(ret); i++) {
+        ret = addKey(predicate, keyList[i]);
+    }
+    return ret;
+}
+
+/**
+ * @brief Read row key (first column) of row as type of this list
+ * @param *row Row
+ * @param *numberKey Output for INTEGER, LONG and TIMESTAMP keys
+ * @param *stringKey Output for STRING keys
+ */
+GSResult RowKeyList::getKey(GSRow *row, int64_t *numberKey,
+        std::string *stringKey) const {
+    GSResult ret;
+    switch (mType) {
+    case GS_TYPE_STRING: {
+        const GSChar *value;
+        ret = gsGetRowFieldAsString(row, 0, &value);
+        if (GS_SUCCEEDED(ret)) {
+            *stringKey = value;
+        }
+        break;
+    }
+    case GS_TYPE_INTEGER: {
+        int32_t value;
+        ret = gsGetRowFieldAsInteger(row, 0, &value);
+        *numberKey = value;
+        break;
+    }
+    case GS_TYPE_LONG:
+        ret = gsGetRowFieldAsLong(row, 0, numberKey);
+        break;
+    default:
+        ret = gsGetRowFieldAsTimestamp(row, 0, numberKey);
+        break;
+    }
+    return ret;
+}
+
+GSType RowKeyList::type() const {
+    return mType;
+}
+
+size_t RowKeyList::size() const {
+    return mType == GS_TYPE_STRING ? mStringList.size() : mNumberList.size();
+}
+
+int64_t RowKeyList::numberAt(size_t i) const {
+    return mNumberList[i];
+}
+
+const std::string& RowKeyList::stringAt(size_t i) const {
+    return mStringList[i];
+}
+
+}  // namespace griddb
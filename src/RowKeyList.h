@@ -0,0 +1,64 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef ROWKEYLIST_H
+#define ROWKEYLIST_H
+
+#include <napi.h>
+#include <string>
+#include <vector>
+#include "gridstore.h"
+
+namespace griddb {
+
+// Row keys of one type converted from JS input, so that they can be used
+// without N-API calls, e.g. on worker threads.
+// INTEGER, LONG and TIMESTAMP keys are kept as int64_t.
+class RowKeyList {
+ public:
+    explicit RowKeyList(GSType type);
+
+    static bool isSupported(GSType type);
+
+    // Convert array or TypedArray of keys. Throw Napi::Error on error
+    void fromValue(const Napi::Env &env, const Napi::Value &value);
+    // Convert STRING keys concatenated in one buffer
+    void fromStringBuffer(const Napi::Env &env, const Napi::Value &buffer,
+            const Napi::Value &offsets);
+    GSResult addKeys(GSRowKeyPredicate *predicate) const;
+    GSResult addDistinctKeys(GSRowKeyPredicate *predicate) const;
+    GSResult getKey(GSRow *row, int64_t *numberKey,
+            std::string *stringKey) const;
+
+    GSType type() const;
+    size_t size() const;
+    int64_t numberAt(size_t i) const;
+    const std::string& stringAt(size_t i) const;
+
+ private:
+    GSType mType;
+    std::vector<int64_t> mNumberList;
+    std::vector<std::string> mStringList;
+
+    void fromTypedArray(const Napi::Env &env, const Napi::TypedArray &array);
+    int64_t toNumberKey(const Napi::Env &env, Napi::Value value) const;
+    int64_t checkRange(const Napi::Env &env, int64_t key) const;
+    GSResult addKey(GSRowKeyPredicate *predicate, int64_t key) const;
+};
+
+}  // namespace griddb
+
+#endif  // ROWKEYLIST_H
@@ -16,6 +16,7 @@
 
 #include <string>
 #include "RowKeyPredicate.h"
+#include "RowKeyList.h"
 
 namespace griddb {
 
@@ -256,81 +257,36 @@ Napi::Value RowKeyPredicate::getRange(const Napi::CallbackInfo &info) {
     return array;
 }
 
+/**
+ * @brief Set keys of distinct key predicate.
+ *   setDistinctKeys(keys): Array of keys, or Int32Array, Float64Array,
+ *   BigInt64Array for INTEGER, LONG and TIMESTAMP key type.
+ *   setDistinctKeys(buffer, offsets): STRING keys concatenated in Buffer,
+ *   key i is from offsets[i] to offsets[i + 1].
+ */
 void RowKeyPredicate::setDistinctKeys(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
-    if (info.Length() != 1) {
+    if (info.Length() != 1 && info.Length() != 2) {
         // Throw error
         THROW_EXCEPTION_WITH_STR(env, "Wrong arguments\n", NULL)
         return;
     }
-    Napi::Array arrayForSet = info[0].As<Napi::Array>();
-    size_t keyCount = arrayForSet.Length();
-    GSResult ret;
-    for (size_t i = 0; i < keyCount; i++) {
-        switch (type) {
-        case GS_TYPE_INTEGER: {
-            Napi::Value value = arrayForSet[i];
-            if (!value.IsNumber()) {
-                THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
-                return;
-            }
-            int32_t key = value.ToNumber().Int32Value();
-            ret = gsAddPredicateKeyByInteger(predicate, key);
-            if (!GS_SUCCEEDED(ret)) {
-                THROW_EXCEPTION_WITH_CODE(env, ret, predicate)
-                return;
-            }
-            break;
-        }
-        case GS_TYPE_STRING: {
-            Napi::Value value = arrayForSet[i];
-            if (!value.IsString()) {
-                THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
-                return;
-            }
-            ret = gsAddPredicateKeyByString(predicate,
-                        value.ToString().Utf8Value().c_str());
-            if (!GS_SUCCEEDED(ret)) {
-                THROW_EXCEPTION_WITH_CODE(env, ret, predicate)
-                return;
-            }
-            break;
-        }
-        case GS_TYPE_LONG: {
-            Napi::Value value = arrayForSet[i];
-            if (!value.IsNumber()) {
-                THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
-                return;
-            }
-            int64_t key =  value.ToNumber().Int64Value();
-            ret = gsAddPredicateKeyByLong(predicate, key);
-            if (!GS_SUCCEEDED(ret)) {
-                THROW_EXCEPTION_WITH_CODE(env, ret, predicate)
-                return;
-            }
-            break;
-        }
-        case GS_TYPE_TIMESTAMP: {
-            Napi::Value value = arrayForSet[i];
-            GSTimestamp key;
-            try {
-                key = Util::toGsTimestamp(env, &value);
-            } catch (const Napi::Error &e) {
-                e.ThrowAsJavaScriptException();
-                break;
-            }
-            ret = gsAddPredicateKeyByTimestamp(predicate, key);
-            if (!GS_SUCCEEDED(ret)) {
-                THROW_EXCEPTION_WITH_CODE(env, ret, predicate)
-                return;
-            }
-            break;
-        }
-        default:
-            THROW_EXCEPTION_WITH_STR(env, "Not support type\n", NULL)
-            return;
-            break;
-        }
+    // Convert all keys first, then add them without N-API calls
+    RowKeyList keyList(type);
+    try {
+        if (info.Length() == 1) {
+            keyList.fromValue(env, info[0]);
+        } else {
+            keyList.fromStringBuffer(env, info[0], info[1]);
+        }
+    } catch (const Napi::Error &e) {
+        e.ThrowAsJavaScriptException();
+        return;
+    }
+    GSResult ret = keyList.addKeys(predicate);
+    if (!GS_SUCCEEDED(ret)) {
+        THROW_EXCEPTION_WITH_CODE(env, ret, predicate)
+        return;
     }
 }
 
@@ -0,0 +1,76 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "RowPool.h"
+#include "ExternalMemory.h"
+
+namespace griddb {
+
+RowPool::RowPool(GSContainer *container, int64_t rowSize,
+        std::shared_ptr<MemoryAccount> account) :
+        mContainer(container), mRowSize(rowSize), mMemoryAccount(account) {
+}
+
+RowPool::~RowPool() {
+    for (size_t i = 0; i < mIdleList.size(); i++) {
+        gsCloseRow(&mIdleList[i]);
+        ExternalMemory::remove(mMemoryAccount.get(), MEMORY_ROW, mRowSize);
+    }
+}
+
+/**
+ * @brief Get an idle row, or create a new one when there is no idle row.
+ * @return Row owned by the caller until release() is called, NULL when no
+ *   row can be created
+ */
+GSRow* RowPool::acquire() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mIdleList.empty()) {
+        GSRow *row = mIdleList.back();
+        mIdleList.pop_back();
+        return row;
+    }
+    if (mContainer == NULL) {
+        return NULL;
+    }
+    GSRow *row = NULL;
+    GSResult ret = gsCreateRowByContainer(mContainer, &row);
+    if (!GS_SUCCEEDED(ret)) {
+        return NULL;
+    }
+    ExternalMemory::add(mMemoryAccount.get(), MEMORY_ROW, mRowSize);
+    return row;
+}
+
+void RowPool::release(GSRow *row) {
+    if (row == NULL) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mIdleList.size() < DEFAULT_ROW_POOL_IDLE_SIZE) {
+        mIdleList.push_back(row);
+        return;
+    }
+    gsCloseRow(&row);
+    ExternalMemory::remove(mMemoryAccount.get(), MEMORY_ROW, mRowSize);
+}
+
+void RowPool::detach() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mContainer = NULL;
+}
+
+}  // namespace griddb
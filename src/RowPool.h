@@ -0,0 +1,57 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef ROWPOOL_H
+#define ROWPOOL_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "ExternalMemory.h"
+#include "gridstore.h"
+
+#define DEFAULT_ROW_POOL_IDLE_SIZE 4
+
+namespace griddb {
+
+// GSRow buffers of one container lent to RowSets. Each RowSet reads into
+// its own row, so RowSets of the same container can be iterated in any
+// order. Rows given back are kept for the next RowSet up to a few idle rows
+class RowPool {
+ public:
+    RowPool(GSContainer *container, int64_t rowSize,
+            std::shared_ptr<MemoryAccount> account);
+    ~RowPool();
+
+    // Get an idle row or create one, NULL when the container is closed
+    GSRow* acquire();
+    void release(GSRow *row);
+    // Container handle is closed, only idle rows can be acquired after this
+    void detach();
+
+ private:
+    GSContainer *mContainer;
+    // Estimated bytes of a row reported to ExternalMemory
+    int64_t mRowSize;
+    // Rows may be created and closed on worker threads
+    std::shared_ptr<MemoryAccount> mMemoryAccount;
+    std::vector<GSRow*> mIdleList;
+    std::mutex mMutex;
+};
+
+}  // namespace griddb
+
+#endif  // ROWPOOL_H
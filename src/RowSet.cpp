@@ -15,6 +15,23 @@
 */
 
 #include "RowSet.h"
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "ColumnStats.h"
+#include "Downsample.h"
+#include "ExternalMemory.h"
+#include "GroupTable.h"
+#include "Metrics.h"
+#include "RowView.h"
+#include "StatsSketch.h"
+#include "TopKMerger.h"
+#include "Watchdog.h"
+
+// Estimated bytes of a GSRowSet besides its rows
+#define ROW_SET_OVERHEAD_SIZE 256
 
 namespace griddb {
 
@@ -28,6 +45,13 @@ Napi::Object RowSet::init(Napi::Env env, Napi::Object exports) {
     Napi::Function func = DefineClass(env, "RowSet",
             {   InstanceMethod("hasNext", &RowSet::hasNext),
                 InstanceMethod("next", &RowSet::next),
+                InstanceMethod("nextView", &RowSet::nextView),
+                InstanceMethod("aggregate", &RowSet::aggregate),
+                InstanceMethod("groupBy", &RowSet::groupBy),
+                InstanceMethod("sketch", &RowSet::sketch),
+                InstanceMethod("downsample", &RowSet::downsample),
+                InstanceMethod("close", &RowSet::close),
+                StaticMethod("mergeTopK", &RowSet::mergeTopK),
                 InstanceAccessor("type", &RowSet::getType, &
                         RowSet::setReadonlyAttribute),
                 InstanceAccessor("size", &RowSet::getSize,
@@ -46,31 +70,37 @@ Napi::Object RowSet::init(Napi::Env env, Napi::Object exports) {
 }
 
 RowSet::RowSet(const Napi::CallbackInfo& info) :
-        Napi::ObjectWrap<RowSet>(info) {
+        Napi::ObjectWrap<RowSet>(info), mRowSet(NULL), mRow(NULL),
+        mNativeBytes(0), mProjected(false) {
     Napi::Env env = info.Env();
-    if (info.Length() != 3 || !info[0].IsExternal() || !info[1].IsExternal()
-            || !info[2].IsExternal()) {
+    if (info.Length() < 4 || info.Length() > 5 || !info[0].IsExternal()
+            || !info[1].IsExternal() || !info[2].IsExternal()
+            || !info[3].IsExternal()
+            || (info.Length() == 5 && !info[4].IsExternal())) {
         // Throw error
         THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
         return;
     }
 
     mRowSet = info[0].As<Napi::External<GSRowSet>>().Data();
-    mContainerInfo = info[1].As<Napi::External<GSContainerInfo >>().Data();
+    mSchema = info[1].As<Napi::External<ContainerSchema>>().Data()->
+            shared_from_this();
     mRow = info[2].As<Napi::External<GSRow >>().Data();
+    mRowPool = *info[3].As<Napi::External<
+            std::shared_ptr<RowPool> >>().Data();
+    if (info.Length() == 5) {
+        mProjection = *info[4].As<Napi::External<std::vector<int> >>().Data();
+        mProjected = true;
+    }
     if (mRowSet != NULL) {
+        Metrics::addGauge(GAUGE_OPEN_ROW_SETS, 1);
         mType = gsGetRowSetType(mRowSet);
-    }
-
-    try {
-        typeList = new GSType[mContainerInfo->columnCount]();
-    } catch (std::bad_alloc&) {
-        THROW_EXCEPTION_WITH_STR(env, "Memory allocation error", mRowSet)
-        return;
-    }
-
-    for (int i = 0; i < static_cast<int>(mContainerInfo->columnCount); i++) {
-        typeList[i] = mContainerInfo->columnInfoList[i].type;
+        mNativeBytes = ROW_SET_OVERHEAD_SIZE;
+        if (mType == GS_ROW_SET_CONTAINER_ROWS) {
+            mNativeBytes += gsGetRowSetSize(mRowSet) *
+                    mSchema->estimatedRowSize();
+        }
+        ExternalMemory::add(env, MEMORY_ROW_SET, mNativeBytes);
     }
 }
 
@@ -82,11 +112,26 @@ Napi::Value RowSet::hasNext(const Napi::CallbackInfo &info) {
 
 Napi::Value RowSet::next(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("RowSet.next", info);
     GSRowSetType type = mType;
     bool hasNextRow;
     GSAggregationResult *aggResult = NULL;
     GSQueryAnalysisEntry *queryResult = NULL;
     GSQueryAnalysisEntry gsQueryAnalysis = GS_QUERY_ANALYSIS_ENTRY_INITIALIZER;
+    // Resolve columns option before the row is consumed
+    std::vector<int> projection;
+    const std::vector<int> *rowProjection = mProjected ? &mProjection : NULL;
+    try {
+        if (info.Length() > 0 && type == GS_ROW_SET_CONTAINER_ROWS &&
+                mSchema->toProjectionOption(env, info[0], &projection)) {
+            rowProjection = &projection;
+        }
+    } catch (const Napi::Error &e) {
+        e.ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    PhaseTimer timer(CALL_ROWSET_NEXT);
+    timer.enter(PHASE_EXECUTE);
     switch (type) {
     case (GS_ROW_SET_CONTAINER_ROWS):
         this->nextRow(env, &hasNextRow);
@@ -111,11 +156,15 @@ Napi::Value RowSet::next(const Napi::CallbackInfo &info) {
         return env.Null();
     }
 
+    timer.enter(PHASE_BUILD);
     Napi::Value returnWrapper;
     switch (type) {
     case GS_ROW_SET_CONTAINER_ROWS: {
-        returnWrapper = Util::fromRow(env, mRow, mContainerInfo->columnCount,
-                typeList);
+        if (rowProjection) {
+            returnWrapper = mSchema->fromRow(env, mRow, *rowProjection);
+        } else {
+            returnWrapper = mSchema->fromRow(env, mRow);
+        }
         break;
     }
     case GS_ROW_SET_AGGREGATION_RESULT: {
@@ -150,19 +199,543 @@ Napi::Value RowSet::next(const Napi::CallbackInfo &info) {
         return env.Null();
     }
 
+    timer.finish();
     return returnWrapper;
 }
 
+// Aggregation operations of RowSet.aggregate and RowSet.groupBy
+enum AggregateOp {
+    AGGREGATE_SUM = 1 << 0,
+    AGGREGATE_MIN = 1 << 1,
+    AGGREGATE_MAX = 1 << 2,
+    AGGREGATE_MEAN = 1 << 3,
+    AGGREGATE_COUNT = 1 << 4,
+    AGGREGATE_STDDEV = 1 << 5
+};
+
+static const char* const AGGREGATE_OP_NAMES[] = {
+    "sum", "min", "max", "mean", "count", "stddev"
+};
+#define AGGREGATE_OP_COUNT 6
+
+// One aggregated column, values are buffered as a chunk
+struct AggregateColumn {
+    std::string key;
+    int column;
+    int opFlags;
+    ReadNumberFunc reader;
+    // Reader of integral column, its values are summed exactly
+    ReadIntegerFunc integerReader;
+    std::vector<double> chunk;
+    std::vector<int64_t> integerChunk;
+    ColumnStats stats;
+};
+
+/**
+ * @brief Parse object of column name to array of operations.
+ *   Throw Napi::Error on error
+ */
+static void toAggregateColumnList(const Napi::Env &env,
+        const Napi::Value &value, const ContainerSchema &schema,
+        std::vector<AggregateColumn> *columnList) {
+    if (!value.IsObject() || value.IsArray()) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Wrong arguments")
+    }
+    Napi::Object spec = value.As<Napi::Object>();
+    Napi::Array keys = spec.GetPropertyNames();
+    columnList->resize(keys.Length());
+    for (uint32_t i = 0; i < keys.Length(); i++) {
+        AggregateColumn &column = (*columnList)[i];
+        column.key = keys.Get(i).ToString().Utf8Value();
+        column.column = schema.columnIndex(column.key);
+        if (column.column < 0) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "Column not found")
+        }
+        column.reader = ColumnStats::numberReader(
+                schema.columnType(column.column));
+        if (column.reader == NULL) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "Column is not numeric")
+        }
+        column.integerReader = ColumnStats::integerReader(
+                schema.columnType(column.column));
+        Napi::Value ops = spec.Get(column.key);
+        if (!ops.IsArray()) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "Wrong arguments")
+        }
+        Napi::Array opArray = ops.As<Napi::Array>();
+        column.opFlags = 0;
+        for (uint32_t j = 0; j < opArray.Length(); j++) {
+            std::string name = opArray.Get(j).ToString().Utf8Value();
+            int op = 0;
+            for (int k = 0; k < AGGREGATE_OP_COUNT; k++) {
+                if (name == AGGREGATE_OP_NAMES[k]) {
+                    op = 1 << k;
+                }
+            }
+            if (op == 0) {
+                THROW_CPP_EXCEPTION_WITH_STR(env, "Not support aggregation")
+            }
+            column.opFlags |= op;
+        }
+    }
+}
+
+// Result of operation, NaN if there is no value for it
+static double toAggregateResult(const ColumnStats &stats, int op) {
+    bool empty = stats.count() == 0;
+    switch (op) {
+    case AGGREGATE_SUM:
+        return stats.sum();
+    case AGGREGATE_MIN:
+        return empty ? NAN : stats.min();
+    case AGGREGATE_MAX:
+        return empty ? NAN : stats.max();
+    case AGGREGATE_MEAN:
+        return empty ? NAN : stats.mean();
+    case AGGREGATE_COUNT:
+        return static_cast<double>(stats.count());
+    default:
+        return stats.count() < 2 ? NAN : stats.stddev();
+    }
+}
+
+/**
+ * @brief Move to the next row without converting its fields. The row is
+ *   read into a row of its own, so it stays valid after later next() calls
+ *   until RowView.release() or GC. The columns option of the RowSet
+ *   applies to the view
+ * @return RowView object, or null when there is no more row
+ */
+Napi::Value RowSet::nextView(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("RowSet.nextView", info);
+    if (mType != GS_ROW_SET_CONTAINER_ROWS) {
+        THROW_EXCEPTION_WITH_STR(env, "Not support method", mRowSet)
+        return env.Null();
+    }
+    if (!this->hasNext()) {
+        return env.Null();
+    }
+    GSRow *row = mRowPool->acquire();
+    if (row == NULL) {
+        THROW_EXCEPTION_WITH_STR(env, "Can't create row of container",
+                mRowSet)
+        return env.Null();
+    }
+    GSResult ret = gsGetNextRow(mRowSet, row);
+    if (!GS_SUCCEEDED(ret)) {
+        mRowPool->release(row);
+        THROW_EXCEPTION_WITH_CODE(env, ret, mRowSet)
+        return env.Null();
+    }
+    Metrics::add(COUNTER_ROWS_READ, 1);
+
+    Napi::EscapableHandleScope scope(env);
+    auto rowPtr = Napi::External<GSRow>::New(env, row);
+    auto schemaPtr = Napi::External<ContainerSchema>::New(env,
+            const_cast<ContainerSchema*>(mSchema.get()));
+    auto rowPoolPtr = Napi::External<std::shared_ptr<RowPool> >::New(env,
+            &mRowPool);
+    std::vector<napi_value> args = { rowPtr, schemaPtr, rowPoolPtr };
+    if (mProjected) {
+        args.push_back(Napi::External<std::vector<int> >::New(env,
+                &mProjection));
+    }
+#if NAPI_VERSION > 5
+    return scope.Escape(Util::getInstanceData(env, "RowView")->New(args))
+            .ToObject();
+#else
+    return scope.Escape(RowView::constructor.New(args)).ToObject();
+#endif
+}
+
+/**
+ * @brief Aggregate numeric columns of remaining rows natively, without
+ *   creating JS values for rows. Rows are consumed.
+ * @param info[0] Object of column name to array of operations:
+ *   "sum", "min", "max", "mean", "count", "stddev" (sample)
+ * @return Object of column name to object of operation to result.
+ *   NULL field is not counted. min, max, mean are null for no value
+ */
+Napi::Value RowSet::aggregate(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("RowSet.aggregate", info);
+    if (info.Length() != 1) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", mRowSet)
+        return env.Null();
+    }
+    if (mType != GS_ROW_SET_CONTAINER_ROWS) {
+        THROW_EXCEPTION_WITH_STR(env, "type for rowset is not correct",
+                mRowSet)
+        return env.Null();
+    }
+    std::vector<AggregateColumn> columnList;
+    try {
+        toAggregateColumnList(env, info[0], *mSchema, &columnList);
+    } catch (const Napi::Error &e) {
+        e.ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    for (size_t i = 0; i < columnList.size(); i++) {
+        if (columnList[i].integerReader != NULL) {
+            columnList[i].integerChunk.reserve(COLUMN_CHUNK_SIZE);
+        } else {
+            columnList[i].chunk.reserve(COLUMN_CHUNK_SIZE);
+        }
+    }
+
+    // Read rows into column chunks, reduce each chunk when it is full
+    GSResult ret;
+    double value;
+    int64_t integerValue;
+    bool isNull;
+    while (gsHasNextRow(mRowSet)) {
+        ret = gsGetNextRow(mRowSet, mRow);
+        if (!GS_SUCCEEDED(ret)) {
+            THROW_EXCEPTION_WITH_CODE(env, ret, mRowSet)
+            return env.Null();
+        }
+        Metrics::add(COUNTER_ROWS_READ, 1);
+        for (size_t i = 0; i < columnList.size(); i++) {
+            AggregateColumn &column = columnList[i];
+            if (column.integerReader != NULL) {
+                ret = column.integerReader(mRow, column.column,
+                        &integerValue, &isNull);
+                if (!GS_SUCCEEDED(ret)) {
+                    THROW_EXCEPTION_WITH_CODE(env, ret, mRow)
+                    return env.Null();
+                }
+                if (isNull) {
+                    continue;
+                }
+                column.integerChunk.push_back(integerValue);
+                if (column.integerChunk.size() == COLUMN_CHUNK_SIZE) {
+                    column.stats.addIntegerChunk(column.integerChunk.data(),
+                            column.integerChunk.size());
+                    column.integerChunk.clear();
+                }
+                continue;
+            }
+            ret = column.reader(mRow, column.column, &value, &isNull);
+            if (!GS_SUCCEEDED(ret)) {
+                THROW_EXCEPTION_WITH_CODE(env, ret, mRow)
+                return env.Null();
+            }
+            if (isNull) {
+                continue;
+            }
+            column.chunk.push_back(value);
+            if (column.chunk.size() == COLUMN_CHUNK_SIZE) {
+                column.stats.addChunk(column.chunk.data(),
+                        column.chunk.size());
+                column.chunk.clear();
+            }
+        }
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    for (size_t i = 0; i < columnList.size(); i++) {
+        AggregateColumn &column = columnList[i];
+        column.stats.addChunk(column.chunk.data(), column.chunk.size());
+        column.stats.addIntegerChunk(column.integerChunk.data(),
+                column.integerChunk.size());
+        bool isTimestamp =
+                mSchema->columnType(column.column) == GS_TYPE_TIMESTAMP;
+        Napi::Object output = Napi::Object::New(env);
+        for (int k = 0; k < AGGREGATE_OP_COUNT; k++) {
+            int op = 1 << k;
+            if (!(column.opFlags & op)) {
+                continue;
+            }
+            double opResult = toAggregateResult(column.stats, op);
+            if (std::isnan(opResult) && op != AGGREGATE_SUM) {
+                output.Set(AGGREGATE_OP_NAMES[k], env.Null());
+            } else if (isTimestamp &&
+                    (op == AGGREGATE_MIN || op == AGGREGATE_MAX)) {
+                GSTimestamp timestamp = static_cast<GSTimestamp>(opResult);
+                output.Set(AGGREGATE_OP_NAMES[k],
+                        Util::fromTimestamp(env, &timestamp));
+            } else {
+                output.Set(AGGREGATE_OP_NAMES[k],
+                        Napi::Number::New(env, opResult));
+            }
+        }
+        result.Set(column.key, output);
+    }
+    return result;
+}
+
+static bool isNullField(GSRow *row, int column) {
+    GSBool nullValue;
+    GSResult ret = gsGetRowFieldNull(row, column, &nullValue);
+    return GS_SUCCEEDED(ret) && nullValue == GS_TRUE;
+}
+
+/**
+ * @brief Read group key field as one word: string id of interner,
+ *   bool, integer, or bits of floating point number.
+ */
+static GSResult readKeyWord(GSRow *row, int column, GSType type,
+        StringInterner *interner, uint64_t *word, bool *isNull) {
+    GSResult ret;
+    *word = 0;
+    *isNull = false;
+    switch (type) {
+    case GS_TYPE_STRING: {
+        const GSChar *value;
+        ret = gsGetRowFieldAsString(row, column, &value);
+        if (GS_SUCCEEDED(ret)) {
+            size_t length = strlen(value);
+            *isNull = length == 0 && isNullField(row, column);
+            if (!*isNull) {
+                *word = interner->intern(value, length);
+            }
+        }
+        return ret;
+    }
+    case GS_TYPE_BOOL: {
+        GSBool value;
+        ret = gsGetRowFieldAsBool(row, column, &value);
+        *word = value ? 1 : 0;
+        *isNull = GS_SUCCEEDED(ret) && !value && isNullField(row, column);
+        return ret;
+    }
+    case GS_TYPE_LONG:
+    case GS_TYPE_TIMESTAMP: {
+        int64_t value;
+        ret = type == GS_TYPE_LONG ?
+                gsGetRowFieldAsLong(row, column, &value) :
+                gsGetRowFieldAsTimestamp(row, column, &value);
+        *word = static_cast<uint64_t>(value);
+        *isNull = GS_SUCCEEDED(ret) && value == 0 &&
+                isNullField(row, column);
+        return ret;
+    }
+    default: {
+        double value = 0;
+        ret = ColumnStats::numberReader(type)(row, column, &value, isNull);
+        if (value == 0) {
+            value = 0;  // Same group for -0
+        } else if (std::isnan(value)) {
+            value = NAN;
+        }
+        memcpy(word, &value, sizeof(value));
+        return ret;
+    }
+    }
+}
+
+static bool isGroupKeyType(GSType type) {
+    return type == GS_TYPE_STRING || type == GS_TYPE_BOOL ||
+            ColumnStats::numberReader(type) != NULL;
+}
+
+/**
+ * @brief Group remaining rows by key columns natively and aggregate
+ *   numeric columns of each group. Rows are consumed.
+ * @param info[0] Array of key column names
+ * @param info[1] Optional object of column name to array of operations,
+ *   same as RowSet.aggregate
+ * @return Columnar result: {count, keys: {column: values},
+ *   rows: Float64Array, values: {column: {operation: Float64Array}}}.
+ *   Values of numeric keys are Float64Array and NaN for NULL; values of
+ *   string and bool keys are array. Missing results are NaN
+ */
+Napi::Value RowSet::groupBy(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("RowSet.groupBy", info);
+    if (info.Length() < 1 || info.Length() > 2 || !info[0].IsArray()) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", mRowSet)
+        return env.Null();
+    }
+    if (mType != GS_ROW_SET_CONTAINER_ROWS) {
+        THROW_EXCEPTION_WITH_STR(env, "type for rowset is not correct",
+                mRowSet)
+        return env.Null();
+    }
+    std::vector<int> keyColumnList;
+    std::vector<AggregateColumn> columnList;
+    try {
+        mSchema->toProjection(env, info[0], &keyColumnList);
+        if (info.Length() == 2) {
+            toAggregateColumnList(env, info[1], *mSchema, &columnList);
+        }
+    } catch (const Napi::Error &e) {
+        e.ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    // Last key word is bit mask of NULL key fields
+    if (keyColumnList.empty() || keyColumnList.size() >= 64) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong number of key columns", mRowSet)
+        return env.Null();
+    }
+    for (size_t k = 0; k < keyColumnList.size(); k++) {
+        if (!isGroupKeyType(mSchema->columnType(keyColumnList[k]))) {
+            THROW_EXCEPTION_WITH_STR(env, "Type is not support", mRowSet)
+            return env.Null();
+        }
+    }
+
+    size_t keyCount = keyColumnList.size();
+    size_t columnCount = columnList.size();
+    GroupTable table(keyCount + 1);
+    StringInterner interner;
+    std::vector<uint64_t> key(keyCount + 1);
+    std::vector<double> rowCountList;
+    std::vector<ColumnStats> statsList;
+    GSResult ret;
+    double value;
+    int64_t integerValue;
+    bool isNull;
+    while (gsHasNextRow(mRowSet)) {
+        ret = gsGetNextRow(mRowSet, mRow);
+        if (!GS_SUCCEEDED(ret)) {
+            THROW_EXCEPTION_WITH_CODE(env, ret, mRowSet)
+            return env.Null();
+        }
+        Metrics::add(COUNTER_ROWS_READ, 1);
+        key[keyCount] = 0;
+        for (size_t k = 0; k < keyCount; k++) {
+            ret = readKeyWord(mRow, keyColumnList[k],
+                    mSchema->columnType(keyColumnList[k]), &interner,
+                    &key[k], &isNull);
+            if (!GS_SUCCEEDED(ret)) {
+                THROW_EXCEPTION_WITH_CODE(env, ret, mRow)
+                return env.Null();
+            }
+            if (isNull) {
+                key[k] = 0;
+                key[keyCount] |= 1ULL << k;
+            }
+        }
+        uint32_t group = table.findOrInsert(key.data());
+        if (group == rowCountList.size()) {
+            rowCountList.push_back(0);
+            statsList.resize(statsList.size() + columnCount);
+        }
+        rowCountList[group]++;
+        for (size_t i = 0; i < columnCount; i++) {
+            AggregateColumn &column = columnList[i];
+            ColumnStats &stats = statsList[group * columnCount + i];
+            if (column.integerReader != NULL) {
+                ret = column.integerReader(mRow, column.column,
+                        &integerValue, &isNull);
+                if (GS_SUCCEEDED(ret) && !isNull) {
+                    stats.addInteger(integerValue);
+                }
+            } else {
+                ret = column.reader(mRow, column.column, &value, &isNull);
+                if (GS_SUCCEEDED(ret) && !isNull) {
+                    stats.add(value);
+                }
+            }
+            if (!GS_SUCCEEDED(ret)) {
+                THROW_EXCEPTION_WITH_CODE(env, ret, mRow)
+                return env.Null();
+            }
+        }
+    }
+
+    size_t groupCount = table.groupCount();
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("count", Napi::Number::New(env,
+            static_cast<double>(groupCount)));
+
+    // Keys, JS string of each interned string is created once
+    std::vector<Napi::Value> stringList(interner.size());
+    for (size_t i = 0; i < interner.size(); i++) {
+        stringList[i] = Napi::String::New(env,
+                interner.at(static_cast<uint32_t>(i)));
+    }
+    Napi::Object keys = Napi::Object::New(env);
+    for (size_t k = 0; k < keyCount; k++) {
+        GSType type = mSchema->columnType(keyColumnList[k]);
+        Napi::Value keyValues;
+        if (type == GS_TYPE_STRING || type == GS_TYPE_BOOL) {
+            Napi::Array array = Napi::Array::New(env, groupCount);
+            for (uint32_t g = 0; g < groupCount; g++) {
+                const uint64_t *groupKey = table.keyAt(g);
+                if (groupKey[keyCount] & (1ULL << k)) {
+                    array.Set(g, env.Null());
+                } else if (type == GS_TYPE_STRING) {
+                    array.Set(g, stringList[groupKey[k]]);
+                } else {
+                    array.Set(g, Napi::Boolean::New(env, groupKey[k] != 0));
+                }
+            }
+            keyValues = array;
+        } else {
+            Napi::Float64Array array = Napi::Float64Array::New(env,
+                    groupCount);
+            for (uint32_t g = 0; g < groupCount; g++) {
+                const uint64_t *groupKey = table.keyAt(g);
+                if (groupKey[keyCount] & (1ULL << k)) {
+                    array[g] = NAN;
+                } else if (type == GS_TYPE_FLOAT || type == GS_TYPE_DOUBLE) {
+                    memcpy(&array[g], &groupKey[k], sizeof(double));
+                } else {
+                    array[g] = static_cast<double>(
+                            static_cast<int64_t>(groupKey[k]));
+                }
+            }
+            keyValues = array;
+        }
+        keys.Set(mSchema->columnName(keyColumnList[k]), keyValues);
+    }
+    result.Set("keys", keys);
+
+    Napi::Float64Array rows = Napi::Float64Array::New(env, groupCount);
+    std::copy(rowCountList.begin(), rowCountList.end(), rows.Data());
+    result.Set("rows", rows);
+
+    Napi::Object values = Napi::Object::New(env);
+    for (size_t i = 0; i < columnCount; i++) {
+        Napi::Object output = Napi::Object::New(env);
+        for (int k = 0; k < AGGREGATE_OP_COUNT; k++) {
+            int op = 1 << k;
+            if (!(columnList[i].opFlags & op)) {
+                continue;
+            }
+            Napi::Float64Array array = Napi::Float64Array::New(env,
+                    groupCount);
+            for (size_t g = 0; g < groupCount; g++) {
+                array[g] = toAggregateResult(
+                        statsList[g * columnCount + i], op);
+            }
+            output.Set(AGGREGATE_OP_NAMES[k], array);
+        }
+        values.Set(columnList[i].key, output);
+    }
+    result.Set("values", values);
+    return result;
+}
+
 RowSet::~RowSet() {
+    release(Env());
+}
+
+void RowSet::release(Napi::Env env) {
     if (mRowSet != NULL) {
         gsCloseRowSet(&mRowSet);
         mRowSet = NULL;
+        Metrics::addGauge(GAUGE_OPEN_ROW_SETS, -1);
+        ExternalMemory::remove(env, MEMORY_ROW_SET, mNativeBytes);
     }
-    if (typeList) {
-        delete[] typeList;
+    if (mRow != NULL) {
+        mRowPool->release(mRow);
+        mRow = NULL;
     }
 }
 
+/**
+ * @brief Close the row set handle now instead of on GC. Calling again does
+ *   nothing
+ */
+Napi::Value RowSet::close(const Napi::CallbackInfo &info) {
+    release(info.Env());
+    return info.Env().Undefined();
+}
+
 /**
  *  Throw exception when set value to readonly attribute
  */
@@ -188,6 +761,10 @@ Napi::Value RowSet::getSize(const Napi::CallbackInfo &info) {
 * @return Returns whether a Row set has at least one Row ahead of the current cursor position
 */
 bool RowSet::hasNext() {
+    if (mRowSet == NULL) {
+        // Closed
+        return false;
+    }
     GSRowSetType type;
     type = this->type();
     switch (type) {
@@ -218,8 +795,317 @@ void RowSet::nextRow(Napi::Env env, bool* hasNextRow) {
         GSResult ret = gsGetNextRow(mRowSet, mRow);
         if (!GS_SUCCEEDED(ret)) {
             THROW_EXCEPTION_WITH_CODE(env, ret, mRowSet)
+            return;
+        }
+        Metrics::add(COUNTER_ROWS_READ, 1);
+    }
+}
+
+/**
+ * @brief Merge rows of RowSets of container rows and keep the first k rows
+ *   in order of orderBy columns. RowSets are read to the end
+ * @param info[0] Array of RowSet
+ * @param info[1] Options {orderBy: "col [ASC|DESC]" or array of them, k}
+ * @return Array of rows
+ */
+Napi::Value RowSet::mergeTopK(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("RowSet.mergeTopK", info);
+    if (info.Length() != 2 || !info[0].IsArray()) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
+        return env.Null();
+    }
+    Napi::Array rowSetList = info[0].As<Napi::Array>();
+    std::vector<RowSet*> sourceList;
+    for (uint32_t i = 0; i < rowSetList.Length(); i++) {
+        Napi::Value value = rowSetList.Get(i);
+        RowSet *rowSet = value.IsObject() ?
+                Napi::ObjectWrap<RowSet>::Unwrap(value.As<Napi::Object>()) :
+                NULL;
+        if (rowSet == NULL || rowSet->mType != GS_ROW_SET_CONTAINER_ROWS) {
+            THROW_EXCEPTION_WITH_STR(env, "type for rowset is not correct",
+                    NULL)
+            return env.Null();
         }
+        sourceList.push_back(rowSet);
+    }
+
+    TopKMerger merger;
+    try {
+        merger.setOptions(env, info[1]);
+        for (size_t i = 0; i < sourceList.size(); i++) {
+            RowSet *rowSet = sourceList[i];
+            merger.setSource(env, rowSet->mSchema);
+            GSResult ret;
+            while (gsHasNextRow(rowSet->mRowSet)) {
+                ret = gsGetNextRow(rowSet->mRowSet, rowSet->mRow);
+                if (!GS_SUCCEEDED(ret)) {
+                    THROW_EXCEPTION_WITH_CODE(env, ret, rowSet->mRowSet)
+                    return env.Null();
+                }
+                Metrics::add(COUNTER_ROWS_READ, 1);
+                ret = merger.offer(rowSet->mRow);
+                if (!GS_SUCCEEDED(ret)) {
+                    THROW_EXCEPTION_WITH_CODE(env, ret, rowSet->mRow)
+                    return env.Null();
+                }
+            }
+        }
+        return merger.toArray(env);
+    } catch (const Napi::Error &e) {
+        e.ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Read {column, <optionName>} of sketch spec.
+ *   Throw Napi::Error on error
+ * @return Column number, -1 if spec is undefined
+ */
+static int toSketchColumn(const Napi::Env &env, const Napi::Value &value,
+        const ContainerSchema &schema, const char *optionName,
+        double defaultOption, double *option) {
+    if (value.IsUndefined()) {
+        return -1;
+    }
+    if (!value.IsObject()) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Wrong arguments")
+    }
+    Napi::Object spec = value.As<Napi::Object>();
+    int column = schema.columnIndex(
+            spec.Get("column").ToString().Utf8Value());
+    if (column < 0) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Column not found")
+    }
+    Napi::Value optionValue = spec.Get(optionName);
+    *option = optionValue.IsUndefined() ? defaultOption :
+            optionValue.ToNumber().DoubleValue();
+    return column;
+}
+
+/**
+ * @brief Read remaining rows into approximate statistics
+ * @param info[0] Object of
+ *   percentiles: {column, compression} t-digest of numeric or TIMESTAMP
+ *     column, compression is 100 by default
+ *   distinct: {column, precision} HyperLogLog of column, precision is 14
+ *     by default
+ * @return StatsSketch object
+ */
+Napi::Value RowSet::sketch(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("RowSet.sketch", info);
+    if (info.Length() != 1 || !info[0].IsObject()) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", mRowSet)
+        return env.Null();
+    }
+    if (mType != GS_ROW_SET_CONTAINER_ROWS) {
+        THROW_EXCEPTION_WITH_STR(env, "type for rowset is not correct",
+                mRowSet)
+        return env.Null();
+    }
+    Napi::Object spec = info[0].As<Napi::Object>();
+    SketchState state;
+    int digestColumn;
+    int distinctColumn;
+    ReadNumberFunc reader = NULL;
+    GSType distinctType = GS_TYPE_NULL;
+    try {
+        double compression;
+        double precision;
+        digestColumn = toSketchColumn(env, spec.Get("percentiles"), *mSchema,
+                "compression", 100, &compression);
+        distinctColumn = toSketchColumn(env, spec.Get("distinct"), *mSchema,
+                "precision", 14, &precision);
+        if (digestColumn >= 0) {
+            reader = ColumnStats::numberReader(
+                    mSchema->columnType(digestColumn));
+            if (reader == NULL) {
+                THROW_CPP_EXCEPTION_WITH_STR(env, "Column is not numeric")
+            }
+            if (!(compression >= TDIGEST_MIN_COMPRESSION &&
+                    compression <= TDIGEST_MAX_COMPRESSION)) {
+                THROW_CPP_EXCEPTION_WITH_STR(env, "Invalid compression")
+            }
+            state.digest.reset(new TDigest(compression));
+        }
+        if (distinctColumn >= 0) {
+            distinctType = mSchema->columnType(distinctColumn);
+            if (!isGroupKeyType(distinctType) &&
+                    distinctType != GS_TYPE_GEOMETRY &&
+                    distinctType != GS_TYPE_BLOB) {
+                THROW_CPP_EXCEPTION_WITH_STR(env, "Type is not support")
+            }
+            if (!(precision >= HyperLogLog::MIN_PRECISION &&
+                    precision <= HyperLogLog::MAX_PRECISION)) {
+                THROW_CPP_EXCEPTION_WITH_STR(env, "Invalid precision")
+            }
+            state.distinct.reset(
+                    new HyperLogLog(static_cast<int>(precision)));
+        }
+    } catch (const Napi::Error &e) {
+        e.ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    GSResult ret;
+    double value;
+    bool isNull;
+    FieldValue field;
+    while (gsHasNextRow(mRowSet)) {
+        ret = gsGetNextRow(mRowSet, mRow);
+        if (!GS_SUCCEEDED(ret)) {
+            THROW_EXCEPTION_WITH_CODE(env, ret, mRowSet)
+            return env.Null();
+        }
+        Metrics::add(COUNTER_ROWS_READ, 1);
+        if (reader) {
+            ret = reader(mRow, digestColumn, &value, &isNull);
+            if (!GS_SUCCEEDED(ret)) {
+                THROW_EXCEPTION_WITH_CODE(env, ret, mRow)
+                return env.Null();
+            }
+            if (!isNull) {
+                state.digest->add(value);
+            }
+        }
+        if (state.distinct) {
+            ret = readFieldValue(mRow, distinctColumn, distinctType, &field);
+            if (!GS_SUCCEEDED(ret)) {
+                THROW_EXCEPTION_WITH_CODE(env, ret, mRow)
+                return env.Null();
+            }
+            if (!field.isNull) {
+                state.distinct->add(hashFieldValue(field));
+            }
+        }
+    }
+
+    Napi::EscapableHandleScope scope(env);
+    auto statePtr = Napi::External<SketchState>::New(env, &state);
+#if NAPI_VERSION > 5
+    return scope.Escape(
+            Util::getInstanceData(env, "StatsSketch")->New({statePtr}));
+#else
+    return scope.Escape(StatsSketch::constructor.New({statePtr}));
+#endif
+}
+
+/**
+ * @brief Read remaining rows as points of time and value columns and
+ *   reduce them for charting. Rows with NULL time or value are skipped.
+ *   Rows should be in time order, as rows of time series ranges are
+ * @param info[0] Object of
+ *   timeColumn: TIMESTAMP or numeric column, the first column by default
+ *   valueColumn: numeric column
+ *   method: "lttb" (default), "minmax" or "avg"
+ *   buckets: number of buckets
+ * @return {time: Float64Array, value: Float64Array}, time is in
+ *   milliseconds for TIMESTAMP column
+ */
+Napi::Value RowSet::downsample(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("RowSet.downsample", info);
+    if (info.Length() != 1 || !info[0].IsObject()) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", mRowSet)
+        return env.Null();
+    }
+    if (mType != GS_ROW_SET_CONTAINER_ROWS) {
+        THROW_EXCEPTION_WITH_STR(env, "type for rowset is not correct",
+                mRowSet)
+        return env.Null();
+    }
+    Napi::Object options = info[0].As<Napi::Object>();
+    Napi::Value timeName = options.Get("timeColumn");
+    int timeColumn = timeName.IsUndefined() ? 0 :
+            mSchema->columnIndex(timeName.ToString().Utf8Value());
+    int valueColumn = mSchema->columnIndex(
+            options.Get("valueColumn").ToString().Utf8Value());
+    if (timeColumn < 0 || valueColumn < 0) {
+        THROW_EXCEPTION_WITH_STR(env, "Column not found", mRowSet)
+        return env.Null();
+    }
+    ReadNumberFunc timeReader =
+            ColumnStats::numberReader(mSchema->columnType(timeColumn));
+    ReadNumberFunc valueReader =
+            ColumnStats::numberReader(mSchema->columnType(valueColumn));
+    if (timeReader == NULL || valueReader == NULL) {
+        THROW_EXCEPTION_WITH_STR(env, "Column is not numeric", mRowSet)
+        return env.Null();
+    }
+    Napi::Value bucketValue = options.Get("buckets");
+    if (!bucketValue.IsNumber()) {
+        THROW_EXCEPTION_WITH_STR(env, "buckets should be positive number",
+                mRowSet)
+        return env.Null();
+    }
+    double bucketNumber = bucketValue.As<Napi::Number>().DoubleValue();
+    // Larger values may not fit in size_t
+    if (!std::isfinite(bucketNumber) ||
+            bucketNumber != std::trunc(bucketNumber) ||
+            bucketNumber > 9007199254740992.0) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", mRowSet)
+        return env.Null();
+    }
+    if (bucketNumber < 1) {
+        THROW_EXCEPTION_WITH_STR(env, "buckets should be positive number",
+                mRowSet)
+        return env.Null();
+    }
+    size_t buckets = static_cast<size_t>(bucketNumber);
+    Napi::Value methodValue = options.Get("method");
+    std::string method = methodValue.IsUndefined() ? "lttb" :
+            methodValue.ToString().Utf8Value();
+    if (method != "lttb" && method != "minmax" && method != "avg") {
+        THROW_EXCEPTION_WITH_STR(env, "Not support method", mRowSet)
+        return env.Null();
+    }
+
+    PointSeries input;
+    GSResult ret;
+    double time;
+    double value;
+    bool timeNull;
+    bool valueNull;
+    while (gsHasNextRow(mRowSet)) {
+        ret = gsGetNextRow(mRowSet, mRow);
+        if (!GS_SUCCEEDED(ret)) {
+            THROW_EXCEPTION_WITH_CODE(env, ret, mRowSet)
+            return env.Null();
+        }
+        Metrics::add(COUNTER_ROWS_READ, 1);
+        ret = timeReader(mRow, timeColumn, &time, &timeNull);
+        if (GS_SUCCEEDED(ret)) {
+            ret = valueReader(mRow, valueColumn, &value, &valueNull);
+        }
+        if (!GS_SUCCEEDED(ret)) {
+            THROW_EXCEPTION_WITH_CODE(env, ret, mRow)
+            return env.Null();
+        }
+        if (!timeNull && !valueNull) {
+            input.add(time, value);
+        }
+    }
+
+    PointSeries output;
+    if (method == "lttb") {
+        downsampleLttb(input, buckets, &output);
+    } else if (method == "minmax") {
+        downsampleMinMax(input, buckets, &output);
+    } else {
+        downsampleAverage(input, buckets, &output);
     }
+    Napi::Float64Array timeArray = Napi::Float64Array::New(env,
+            output.size());
+    Napi::Float64Array valueArray = Napi::Float64Array::New(env,
+            output.size());
+    std::copy(output.time.begin(), output.time.end(), timeArray.Data());
+    std::copy(output.value.begin(), output.value.end(), valueArray.Data());
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("time", timeArray);
+    result.Set("value", valueArray);
+    return result;
 }
 
 /**
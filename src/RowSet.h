@@ -18,8 +18,12 @@
 #define ROWSET_H
 
 #include <napi.h>
+#include <memory>
+#include <vector>
 #include "AggregationResult.h"
+#include "ContainerSchema.h"
 #include "QueryAnalysisEntry.h"
+#include "RowPool.h"
 #include "Macro.h"
 
 namespace griddb {
@@ -38,23 +42,38 @@ class RowSet: public Napi::ObjectWrap<RowSet> {
     // NAPI-methods
     Napi::Value hasNext(const Napi::CallbackInfo &info);
     Napi::Value next(const Napi::CallbackInfo &info);
+    Napi::Value nextView(const Napi::CallbackInfo &info);
+    Napi::Value aggregate(const Napi::CallbackInfo &info);
+    Napi::Value groupBy(const Napi::CallbackInfo &info);
+    Napi::Value sketch(const Napi::CallbackInfo &info);
+    Napi::Value downsample(const Napi::CallbackInfo &info);
+    static Napi::Value mergeTopK(const Napi::CallbackInfo &info);
     void setReadonlyAttribute(const Napi::CallbackInfo &info,
             const Napi::Value &value);
     Napi::Value getType(const Napi::CallbackInfo &info);
     Napi::Value getSize(const Napi::CallbackInfo &info);
+    Napi::Value close(const Napi::CallbackInfo &info);
     GSAggregationResult* getNextAggregation(Napi::Env env);
     void getNextQueryAnalysis(Napi::Env env,
             GSQueryAnalysisEntry **queryResult);
 
  private:
     GSRowSet *mRowSet;
-    GSContainerInfo *mContainerInfo;
+    std::shared_ptr<const ContainerSchema> mSchema;
+    // Own row of mRowPool, returned to the pool on release
     GSRow *mRow;
-    GSType* typeList;
+    std::shared_ptr<RowPool> mRowPool;
     GSRowSetType mType;
+    // Estimated bytes of mRowSet reported to ExternalMemory
+    int64_t mNativeBytes;
+    // Columns of rows given by columns option of Query.fetch
+    std::vector<int> mProjection;
+    bool mProjected;
     bool hasNext();
     GSRowSetType type();
     void nextRow(Napi::Env env, bool* hasNextRow);
+    // Close row set handle, can be called more than once
+    void release(Napi::Env env);
 };
 
 }  // namespace griddb
@@ -0,0 +1,173 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "RowView.h"
+#include <string>
+#include "GSException.h"
+#include "Macro.h"
+
+namespace griddb {
+
+#if NAPI_VERSION <= 5
+Napi::FunctionReference RowView::constructor;
+#endif
+
+Napi::Object RowView::init(Napi::Env env, Napi::Object exports) {
+    Napi::HandleScope scope(env);
+
+    Napi::Function func = DefineClass(env, "RowView", {
+            InstanceMethod("get", &RowView::get),
+            InstanceMethod("toArray", &RowView::toArray),
+            InstanceMethod("release", &RowView::release),
+            InstanceAccessor("length", &RowView::getLength,
+                    &RowView::setReadonlyAttribute),
+            InstanceAccessor("released", &RowView::getReleased,
+                    &RowView::setReadonlyAttribute) });
+
+#if NAPI_VERSION > 5
+    Napi::FunctionReference* constructor = new Napi::FunctionReference();
+    *constructor = Napi::Persistent(func);
+    Util::setInstanceData(env, "RowView", constructor);
+#else
+    constructor = Napi::Persistent(func);
+    constructor.SuppressDestruct();
+#endif
+    exports.Set("RowView", func);
+    return exports;
+}
+
+RowView::RowView(const Napi::CallbackInfo &info) :
+        Napi::ObjectWrap<RowView>(info), mRow(NULL), mProjected(false) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 3 || info.Length() > 4 || !info[0].IsExternal()
+            || !info[1].IsExternal() || !info[2].IsExternal()
+            || (info.Length() == 4 && !info[3].IsExternal())) {
+        // Throw error
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
+        return;
+    }
+    mRow = info[0].As<Napi::External<GSRow>>().Data();
+    mSchema = info[1].As<Napi::External<ContainerSchema>>().Data()->
+            shared_from_this();
+    mRowPool = *info[2].As<Napi::External<
+            std::shared_ptr<RowPool> >>().Data();
+    if (info.Length() == 4) {
+        mProjection = *info[3].As<Napi::External<std::vector<int> >>().Data();
+        mProjected = true;
+    }
+}
+
+RowView::~RowView() {
+    releaseRow();
+}
+
+void RowView::releaseRow() {
+    if (mRow != NULL) {
+        mRowPool->release(mRow);
+        mRow = NULL;
+    }
+}
+
+/**
+ * @brief Convert one field of the row
+ * @param info[0] Column number, index into the columns option of the
+ *   RowSet if given, or case insensitive column name
+ * @return Field value
+ */
+Napi::Value RowView::get(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (mRow == NULL) {
+        THROW_EXCEPTION_WITH_STR(env, "Row view is released", NULL)
+        return env.Null();
+    }
+    if (info.Length() != 1) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", mRow)
+        return env.Null();
+    }
+    int column = -1;
+    if (info[0].IsNumber()) {
+        int64_t number = info[0].As<Napi::Number>().Int64Value();
+        size_t length = mProjected ? mProjection.size() :
+                mSchema->columnCount();
+        if (number >= 0 && number < static_cast<int64_t>(length)) {
+            column = mProjected ? mProjection[number] :
+                    static_cast<int>(number);
+        }
+    } else if (info[0].IsString()) {
+        column = mSchema->columnIndex(info[0].As<Napi::String>().Utf8Value());
+    }
+    if (column < 0) {
+        THROW_EXCEPTION_WITH_STR(env, "Column not found", mRow)
+        return env.Null();
+    }
+    try {
+        return mSchema->fromField(env, mRow, column);
+    } catch (const Napi::Error &e) {
+        e.ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Convert all fields, or the fields of the columns option of the
+ *   RowSet, same as the row returned by RowSet.next()
+ * @return Array of field values
+ */
+Napi::Value RowView::toArray(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (mRow == NULL) {
+        THROW_EXCEPTION_WITH_STR(env, "Row view is released", NULL)
+        return env.Null();
+    }
+    try {
+        if (mProjected) {
+            return mSchema->fromRow(env, mRow, mProjection);
+        }
+        return mSchema->fromRow(env, mRow);
+    } catch (const Napi::Error &e) {
+        e.ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Give the row back for the next view. get() and toArray() throw
+ *   after this. Calling again does nothing
+ */
+Napi::Value RowView::release(const Napi::CallbackInfo &info) {
+    releaseRow();
+    return info.Env().Undefined();
+}
+
+Napi::Value RowView::getLength(const Napi::CallbackInfo &info) {
+    size_t length = mProjected ? mProjection.size() : mSchema->columnCount();
+    return Napi::Number::New(info.Env(), static_cast<double>(length));
+}
+
+Napi::Value RowView::getReleased(const Napi::CallbackInfo &info) {
+    return Napi::Boolean::New(info.Env(), mRow == NULL);
+}
+
+/**
+ *  Throw exception when set value to readonly attribute
+ */
+void RowView::setReadonlyAttribute(const Napi::CallbackInfo &info,
+        const Napi::Value &value) {
+    Napi::Env env = info.Env();
+    THROW_EXCEPTION_WITH_STR(env, "Can't set read only attribute", mRow)
+}
+
+}  // namespace griddb
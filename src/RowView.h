@@ -0,0 +1,69 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef ROWVIEW_H
+#define ROWVIEW_H
+
+#include <napi.h>
+#include <memory>
+#include <vector>
+#include "ContainerSchema.h"
+#include "RowPool.h"
+#include "gridstore.h"
+#include "Util.h"
+
+namespace griddb {
+
+// Row given by RowSet.nextView(). Holds a GSRow of the container and
+// converts a field only when it is read, rows skipped by a filter never
+// build JS values of their other fields. release() gives the row back to
+// the RowPool for the next view. With the columns option of the RowSet,
+// toArray(), length and numeric get() see only the selected columns
+class RowView : public Napi::ObjectWrap<RowView> {
+ public:
+#if NAPI_VERSION <= 5
+    // Constructor static variable
+    static Napi::FunctionReference constructor;
+#endif
+    static Napi::Object init(Napi::Env env, Napi::Object exports);
+
+    explicit RowView(const Napi::CallbackInfo &info);
+    ~RowView();
+
+    // N-API methods
+    Napi::Value get(const Napi::CallbackInfo &info);
+    Napi::Value toArray(const Napi::CallbackInfo &info);
+    Napi::Value release(const Napi::CallbackInfo &info);
+    Napi::Value getLength(const Napi::CallbackInfo &info);
+    Napi::Value getReleased(const Napi::CallbackInfo &info);
+    void setReadonlyAttribute(const Napi::CallbackInfo &info,
+            const Napi::Value &value);
+
+ private:
+    GSRow *mRow;
+    std::shared_ptr<const ContainerSchema> mSchema;
+    std::shared_ptr<RowPool> mRowPool;
+    // Column numbers of the RowSet's columns option
+    std::vector<int> mProjection;
+    bool mProjected;
+
+    // Give mRow back to mRowPool, can be called more than once
+    void releaseRow();
+};
+
+}  // namespace griddb
+
+#endif  // ROWVIEW_H
@@ -0,0 +1,329 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Sketch.h"
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#define TDIGEST_BUFFER_FACTOR 5
+
+namespace griddb {
+
+static const double PI = 3.14159265358979323846;
+
+template<typename T>
+static void appendValue(std::string *out, T value) {
+    out->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool readValue(const char *data, size_t length, size_t *offset,
+        T *value) {
+    if (length - *offset < sizeof(T) || *offset > length) {
+        return false;
+    }
+    memcpy(value, data + *offset, sizeof(T));
+    *offset += sizeof(T);
+    return true;
+}
+
+TDigest::TDigest(double compression) :
+        mCompression(compression), mCount(0),
+        mMin(std::numeric_limits<double>::infinity()),
+        mMax(-std::numeric_limits<double>::infinity()),
+        mBufferLimit(static_cast<size_t>(compression *
+                TDIGEST_BUFFER_FACTOR)) {
+}
+
+void TDigest::add(double value, double weight) {
+    if (std::isnan(value) || !(weight > 0)) {
+        return;
+    }
+    mCount += weight;
+    mMin = std::min(mMin, value);
+    mMax = std::max(mMax, value);
+    Centroid centroid = { value, weight };
+    mBuffer.push_back(centroid);
+    if (mBuffer.size() >= mBufferLimit) {
+        compress();
+    }
+}
+
+void TDigest::merge(const TDigest &other) {
+    for (size_t i = 0; i < other.mCentroidList.size(); i++) {
+        add(other.mCentroidList[i].mean, other.mCentroidList[i].weight);
+    }
+    for (size_t i = 0; i < other.mBuffer.size(); i++) {
+        add(other.mBuffer[i].mean, other.mBuffer[i].weight);
+    }
+    // Centroid means lie between min and max of other
+    if (other.mCount > 0) {
+        mMin = std::min(mMin, other.mMin);
+        mMax = std::max(mMax, other.mMax);
+    }
+}
+
+// Scale function k(q) and its inverse
+static double scaleOf(double q, double compression) {
+    return compression / (2 * PI) * std::asin(2 * q - 1);
+}
+
+static double quantileOf(double k, double compression) {
+    if (k >= compression / 4) {
+        return 1;
+    }
+    return (std::sin(k * 2 * PI / compression) + 1) / 2;
+}
+
+void TDigest::compress() {
+    if (mBuffer.empty()) {
+        return;
+    }
+    mBuffer.insert(mBuffer.end(), mCentroidList.begin(), mCentroidList.end());
+    std::sort(mBuffer.begin(), mBuffer.end(),
+            [](const Centroid &a, const Centroid &b) {
+                return a.mean < b.mean;
+            });
+    mCentroidList.clear();
+    Centroid current = mBuffer[0];
+    double weightSoFar = 0;
+    double limit = quantileOf(scaleOf(0, mCompression) + 1, mCompression);
+    for (size_t i = 1; i < mBuffer.size(); i++) {
+        const Centroid &next = mBuffer[i];
+        double q = (weightSoFar + current.weight + next.weight) / mCount;
+        if (q <= limit) {
+            current.weight += next.weight;
+            current.mean += (next.mean - current.mean) * next.weight /
+                    current.weight;
+        } else {
+            weightSoFar += current.weight;
+            mCentroidList.push_back(current);
+            limit = quantileOf(scaleOf(weightSoFar / mCount, mCompression) + 1,
+                    mCompression);
+            current = next;
+        }
+    }
+    mCentroidList.push_back(current);
+    mBuffer.clear();
+}
+
+/**
+ * @brief Interpolate between centers of centroids. Below the first center
+ *   and above the last center, interpolate to min and max
+ */
+double TDigest::quantile(double q) {
+    compress();
+    if (mCentroidList.empty()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    q = std::min(std::max(q, 0.0), 1.0);
+    double index = q * mCount;
+    double prevPosition = 0;
+    double prevValue = mMin;
+    double left = 0;
+    for (size_t i = 0; i < mCentroidList.size(); i++) {
+        const Centroid &centroid = mCentroidList[i];
+        double position = left + centroid.weight / 2;
+        if (index < position) {
+            return prevValue + (centroid.mean - prevValue) *
+                    (index - prevPosition) / (position - prevPosition);
+        }
+        prevPosition = position;
+        prevValue = centroid.mean;
+        left += centroid.weight;
+    }
+    if (mCount <= prevPosition) {
+        return mMax;
+    }
+    return prevValue + (mMax - prevValue) * (index - prevPosition) /
+            (mCount - prevPosition);
+}
+
+double TDigest::compression() const {
+    return mCompression;
+}
+
+double TDigest::count() const {
+    return mCount;
+}
+
+double TDigest::min() const {
+    return mMin;
+}
+
+double TDigest::max() const {
+    return mMax;
+}
+
+// compression, count, min, max, centroid count and centroids
+void TDigest::serialize(std::string *out) {
+    compress();
+    appendValue(out, mCompression);
+    appendValue(out, mCount);
+    appendValue(out, mMin);
+    appendValue(out, mMax);
+    appendValue(out, static_cast<uint32_t>(mCentroidList.size()));
+    for (size_t i = 0; i < mCentroidList.size(); i++) {
+        appendValue(out, mCentroidList[i].mean);
+        appendValue(out, mCentroidList[i].weight);
+    }
+}
+
+bool TDigest::deserialize(const char *data, size_t length, size_t *offset) {
+    uint32_t centroidCount;
+    if (!readValue(data, length, offset, &mCompression) ||
+            !readValue(data, length, offset, &mCount) ||
+            !readValue(data, length, offset, &mMin) ||
+            !readValue(data, length, offset, &mMax) ||
+            !readValue(data, length, offset, &centroidCount) ||
+            !(mCompression >= TDIGEST_MIN_COMPRESSION &&
+            mCompression <= TDIGEST_MAX_COMPRESSION) ||
+            (length - *offset) / sizeof(Centroid) < centroidCount) {
+        return false;
+    }
+    // Count is 0 only for an empty digest
+    if (!std::isfinite(mCount) || mCount < 0 ||
+            (mCount == 0 && centroidCount > 0) ||
+            (mCount > 0 && centroidCount == 0)) {
+        return false;
+    }
+    mBufferLimit = static_cast<size_t>(mCompression * TDIGEST_BUFFER_FACTOR);
+    mBuffer.clear();
+    mCentroidList.resize(centroidCount);
+    for (uint32_t i = 0; i < centroidCount; i++) {
+        readValue(data, length, offset, &mCentroidList[i].mean);
+        readValue(data, length, offset, &mCentroidList[i].weight);
+        if (std::isnan(mCentroidList[i].mean) ||
+                !std::isfinite(mCentroidList[i].weight) ||
+                !(mCentroidList[i].weight > 0)) {
+            mCentroidList.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+HyperLogLog::HyperLogLog(int precision) :
+        mPrecision(precision), mRegisterList(1U << precision) {
+}
+
+// Number of leading zeros of non zero value
+static int leadingZeros(uint64_t value) {
+#if defined(__GNUC__)
+    return __builtin_clzll(value);
+#else
+    int count = 0;
+    while (!(value & (1ULL << 63))) {
+        value <<= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+void HyperLogLog::add(uint64_t hash) {
+    size_t index = static_cast<size_t>(hash >> (64 - mPrecision));
+    uint64_t rest = (hash << mPrecision) | (1ULL << (mPrecision - 1));
+    uint8_t rank = static_cast<uint8_t>(leadingZeros(rest) + 1);
+    if (mRegisterList[index] < rank) {
+        mRegisterList[index] = rank;
+    }
+}
+
+bool HyperLogLog::merge(const HyperLogLog &other) {
+    if (mPrecision != other.mPrecision) {
+        return false;
+    }
+    for (size_t i = 0; i < mRegisterList.size(); i++) {
+        mRegisterList[i] = std::max(mRegisterList[i], other.mRegisterList[i]);
+    }
+    return true;
+}
+
+/**
+ * @brief Raw estimate, with linear counting for small cardinality.
+ *   Hashes are 64 bit, so large range correction is not needed
+ */
+double HyperLogLog::estimate() const {
+    double m = static_cast<double>(mRegisterList.size());
+    double alpha;
+    switch (mRegisterList.size()) {
+    case 16:
+        alpha = 0.673;
+        break;
+    case 32:
+        alpha = 0.697;
+        break;
+    case 64:
+        alpha = 0.709;
+        break;
+    default:
+        alpha = 0.7213 / (1 + 1.079 / m);
+        break;
+    }
+    double sum = 0;
+    size_t zeroCount = 0;
+    for (size_t i = 0; i < mRegisterList.size(); i++) {
+        sum += std::ldexp(1.0, -mRegisterList[i]);
+        if (mRegisterList[i] == 0) {
+            zeroCount++;
+        }
+    }
+    double estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && zeroCount > 0) {
+        return m * std::log(m / static_cast<double>(zeroCount));
+    }
+    return estimate;
+}
+
+int HyperLogLog::precision() const {
+    return mPrecision;
+}
+
+// precision and registers
+void HyperLogLog::serialize(std::string *out) const {
+    appendValue(out, static_cast<uint8_t>(mPrecision));
+    out->append(reinterpret_cast<const char*>(mRegisterList.data()),
+            mRegisterList.size());
+}
+
+bool HyperLogLog::deserialize(const char *data, size_t length,
+        size_t *offset) {
+    uint8_t precision;
+    if (!readValue(data, length, offset, &precision) ||
+            precision < MIN_PRECISION || precision > MAX_PRECISION ||
+            length - *offset < (1U << precision)) {
+        return false;
+    }
+    mPrecision = precision;
+    mRegisterList.assign(data + *offset, data + *offset + (1U << precision));
+    *offset += mRegisterList.size();
+    return true;
+}
+
+// Finalizer of SplitMix64
+uint64_t mixHash(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+}  // namespace griddb
@@ -0,0 +1,100 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef SKETCH_H
+#define SKETCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+// Range of t-digest compression
+#define TDIGEST_MIN_COMPRESSION 10
+#define TDIGEST_MAX_COMPRESSION 10000
+
+namespace griddb {
+
+// Merging t-digest for approximate quantiles. Values are buffered and
+// merged into centroids sized by the arcsine scale function, so that
+// centroids near both tails stay small
+class TDigest {
+ public:
+    explicit TDigest(double compression = 100);
+
+    void add(double value, double weight = 1);
+    void merge(const TDigest &other);
+    // q in [0, 1], NaN if no value is added
+    double quantile(double q);
+
+    double compression() const;
+    double count() const;
+    double min() const;
+    double max() const;
+
+    void serialize(std::string *out);
+    // Read from data, advance *offset. Return false for broken data
+    bool deserialize(const char *data, size_t length, size_t *offset);
+
+ private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    double mCompression;
+    double mCount;
+    double mMin;
+    double mMax;
+    std::vector<Centroid> mCentroidList;
+    std::vector<Centroid> mBuffer;
+    size_t mBufferLimit;
+
+    void compress();
+};
+
+// HyperLogLog for approximate distinct count of 64 bit hashes.
+// 2^precision registers of one byte
+class HyperLogLog {
+ public:
+    explicit HyperLogLog(int precision = 14);
+
+    // Precisions supported
+    static const int MIN_PRECISION = 4;
+    static const int MAX_PRECISION = 18;
+
+    void add(uint64_t hash);
+    // Return false if precisions differ
+    bool merge(const HyperLogLog &other);
+    double estimate() const;
+
+    int precision() const;
+
+    void serialize(std::string *out) const;
+    // Read from data, advance *offset. Return false for broken data
+    bool deserialize(const char *data, size_t length, size_t *offset);
+
+ private:
+    int mPrecision;
+    std::vector<uint8_t> mRegisterList;
+};
+
+// Mix bits of 64 bit value, used to hash numbers for HyperLogLog
+uint64_t mixHash(uint64_t value);
+
+}  // namespace griddb
+
+#endif  // SKETCH_H
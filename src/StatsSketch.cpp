@@ -0,0 +1,299 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "StatsSketch.h"
+#include <string.h>
+#include <cmath>
+#include <limits>
+#include "GroupTable.h"
+
+// Header of serialized sketch: magic, version and flags of parts
+#define SKETCH_MAGIC "GSSK"
+#define SKETCH_MAGIC_SIZE 4
+#define SKETCH_VERSION 1
+#define SKETCH_HAS_DIGEST 1
+#define SKETCH_HAS_DISTINCT 2
+
+namespace griddb {
+
+#if NAPI_VERSION <= 5
+Napi::FunctionReference StatsSketch::constructor;
+#endif
+
+uint64_t hashFieldValue(const FieldValue &value) {
+    switch (value.type) {
+    case GS_TYPE_STRING:
+    case GS_TYPE_GEOMETRY:
+    case GS_TYPE_BLOB:
+        return mixHash(hashBytes(value.bytes.data(), value.bytes.size()));
+    case GS_TYPE_FLOAT:
+    case GS_TYPE_DOUBLE: {
+        double number = value.number;
+        if (number == std::trunc(number) && std::fabs(number) < 9.2e18) {
+            return mixHash(static_cast<uint64_t>(
+                    static_cast<int64_t>(number)));
+        }
+        uint64_t bits;
+        memcpy(&bits, &number, sizeof(bits));
+        return mixHash(bits);
+    }
+    default:
+        return mixHash(static_cast<uint64_t>(value.integer));
+    }
+}
+
+Napi::Object StatsSketch::init(Napi::Env env, Napi::Object exports) {
+    Napi::HandleScope scope(env);
+
+    Napi::Function func = DefineClass(env, "StatsSketch",
+            { InstanceMethod("quantile", &StatsSketch::quantile),
+              InstanceMethod("distinct", &StatsSketch::distinct),
+              InstanceMethod("merge", &StatsSketch::merge),
+              InstanceMethod("toBuffer", &StatsSketch::toBuffer),
+              InstanceAccessor("count", &StatsSketch::getCount, nullptr),
+              InstanceAccessor("min", &StatsSketch::getMin, nullptr),
+              InstanceAccessor("max", &StatsSketch::getMax, nullptr),
+              StaticMethod("fromBuffer", &StatsSketch::fromBuffer)
+            });
+
+#if NAPI_VERSION > 5
+    Napi::FunctionReference* constructor = new Napi::FunctionReference();
+    *constructor = Napi::Persistent(func);
+    Util::setInstanceData(env, "StatsSketch", constructor);
+#else
+    constructor = Napi::Persistent(func);
+    constructor.SuppressDestruct();
+#endif
+    exports.Set("StatsSketch", func);
+    return exports;
+}
+
+/**
+ * @brief Empty sketch without argument, sketch of toBuffer() with Buffer,
+ *   or sketches moved from External<SketchState>
+ */
+StatsSketch::StatsSketch(const Napi::CallbackInfo &info) :
+        Napi::ObjectWrap<StatsSketch>(info) {
+    Napi::Env env = info.Env();
+    if (info.Length() > 1) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
+        return;
+    }
+    if (info.Length() == 0) {
+        return;
+    }
+    if (info[0].IsExternal()) {
+        SketchState *state = info[0].As<Napi::External<SketchState>>().Data();
+        mState.digest = std::move(state->digest);
+        mState.distinct = std::move(state->distinct);
+        return;
+    }
+    try {
+        deserialize(env, info[0], &mState);
+    } catch (const Napi::Error &e) {
+        e.ThrowAsJavaScriptException();
+    }
+}
+
+void StatsSketch::deserialize(const Napi::Env &env, const Napi::Value &buffer,
+        SketchState *state) {
+    if (!buffer.IsTypedArray() ||
+            buffer.As<Napi::TypedArray>().TypedArrayType() !=
+            napi_uint8_array) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Wrong arguments")
+    }
+    Napi::Uint8Array bytes = buffer.As<Napi::Uint8Array>();
+    const char *data = reinterpret_cast<const char*>(bytes.Data());
+    size_t length = bytes.ElementLength();
+    size_t offset = SKETCH_MAGIC_SIZE + 2;
+    if (length < offset || memcmp(data, SKETCH_MAGIC, SKETCH_MAGIC_SIZE) != 0 ||
+            data[SKETCH_MAGIC_SIZE] != SKETCH_VERSION) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Invalid sketch")
+    }
+    int flags = data[SKETCH_MAGIC_SIZE + 1];
+    if (flags & SKETCH_HAS_DIGEST) {
+        state->digest.reset(new TDigest());
+        if (!state->digest->deserialize(data, length, &offset)) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "Invalid sketch")
+        }
+    }
+    if (flags & SKETCH_HAS_DISTINCT) {
+        state->distinct.reset(new HyperLogLog());
+        if (!state->distinct->deserialize(data, length, &offset)) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "Invalid sketch")
+        }
+    }
+}
+
+/**
+ * @brief Approximate quantile of percentiles column
+ * @param info[0] Quantile in [0, 1] or array of them
+ * @return Number or array of numbers, NaN if no value is added
+ */
+Napi::Value StatsSketch::quantile(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() != 1 || !(info[0].IsNumber() || info[0].IsArray())) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
+        return env.Null();
+    }
+    if (!mState.digest) {
+        THROW_EXCEPTION_WITH_STR(env, "No percentiles in sketch", NULL)
+        return env.Null();
+    }
+    if (info[0].IsNumber()) {
+        return Napi::Number::New(env, mState.digest->quantile(
+                info[0].As<Napi::Number>().DoubleValue()));
+    }
+    Napi::Array qList = info[0].As<Napi::Array>();
+    Napi::Array result = Napi::Array::New(env, qList.Length());
+    for (uint32_t i = 0; i < qList.Length(); i++) {
+        double q = qList.Get(i).ToNumber().DoubleValue();
+        result.Set(i, Napi::Number::New(env, mState.digest->quantile(q)));
+    }
+    return result;
+}
+
+/**
+ * @brief Approximate distinct count of distinct column
+ */
+Napi::Value StatsSketch::distinct(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (!mState.distinct) {
+        THROW_EXCEPTION_WITH_STR(env, "No distinct in sketch", NULL)
+        return env.Null();
+    }
+    return Napi::Number::New(env, std::round(mState.distinct->estimate()));
+}
+
+/**
+ * @brief Merge other sketch into this sketch
+ * @param info[0] StatsSketch or Buffer of toBuffer()
+ * @return This sketch
+ */
+Napi::Value StatsSketch::merge(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() != 1 || !info[0].IsObject()) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
+        return env.Null();
+    }
+    SketchState decoded;
+    const SketchState *other;
+    try {
+        if (info[0].IsTypedArray()) {
+            deserialize(env, info[0], &decoded);
+            other = &decoded;
+        } else {
+            StatsSketch *sketch = Napi::ObjectWrap<StatsSketch>::Unwrap(
+                    info[0].As<Napi::Object>());
+            if (sketch == NULL) {
+                // Not a StatsSketch, replace the unwrap error
+                env.GetAndClearPendingException();
+                THROW_CPP_EXCEPTION_WITH_STR(env, "Wrong arguments")
+            }
+            other = &sketch->mState;
+        }
+    } catch (const Napi::Error &e) {
+        e.ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (other->distinct && mState.distinct &&
+            other->distinct->precision() != mState.distinct->precision()) {
+        THROW_EXCEPTION_WITH_STR(env, "Precisions of distinct differ", NULL)
+        return env.Null();
+    }
+    // Merging into itself reads a copy
+    SketchState copy;
+    if (other == &mState) {
+        if (mState.digest) {
+            copy.digest.reset(new TDigest(*mState.digest));
+        }
+        if (mState.distinct) {
+            copy.distinct.reset(new HyperLogLog(*mState.distinct));
+        }
+        other = &copy;
+    }
+    if (other->digest) {
+        if (!mState.digest) {
+            mState.digest.reset(new TDigest(other->digest->compression()));
+        }
+        mState.digest->merge(*other->digest);
+    }
+    if (other->distinct) {
+        if (!mState.distinct) {
+            mState.distinct.reset(
+                    new HyperLogLog(other->distinct->precision()));
+        }
+        mState.distinct->merge(*other->distinct);
+    }
+    return info.This();
+}
+
+Napi::Value StatsSketch::toBuffer(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    std::string out(SKETCH_MAGIC, SKETCH_MAGIC_SIZE);
+    out.push_back(SKETCH_VERSION);
+    out.push_back((mState.digest ? SKETCH_HAS_DIGEST : 0) |
+            (mState.distinct ? SKETCH_HAS_DISTINCT : 0));
+    if (mState.digest) {
+        mState.digest->serialize(&out);
+    }
+    if (mState.distinct) {
+        mState.distinct->serialize(&out);
+    }
+    return Napi::Buffer<char>::Copy(env, out.data(), out.size());
+}
+
+Napi::Value StatsSketch::getCount(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    return Napi::Number::New(env,
+            mState.digest ? mState.digest->count() : 0);
+}
+
+Napi::Value StatsSketch::getMin(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (!mState.digest || mState.digest->count() == 0) {
+        return Napi::Number::New(env,
+                std::numeric_limits<double>::quiet_NaN());
+    }
+    return Napi::Number::New(env, mState.digest->min());
+}
+
+Napi::Value StatsSketch::getMax(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (!mState.digest || mState.digest->count() == 0) {
+        return Napi::Number::New(env,
+                std::numeric_limits<double>::quiet_NaN());
+    }
+    return Napi::Number::New(env, mState.digest->max());
+}
+
+/**
+ * @brief Create sketch from Buffer of toBuffer()
+ */
+Napi::Value StatsSketch::fromBuffer(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() != 1) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
+        return env.Null();
+    }
+#if NAPI_VERSION > 5
+    return Util::getInstanceData(env, "StatsSketch")->New({info[0]});
+#else
+    return StatsSketch::constructor.New({info[0]});
+#endif
+}
+
+}  // namespace griddb
@@ -0,0 +1,72 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef STATSSKETCH_H
+#define STATSSKETCH_H
+
+#include <napi.h>
+#include <memory>
+#include <string>
+#include "Sketch.h"
+#include "FieldValue.h"
+#include "Util.h"
+#include "Macro.h"
+
+namespace griddb {
+
+// Sketches made by RowSet.sketch
+struct SketchState {
+    std::unique_ptr<TDigest> digest;
+    std::unique_ptr<HyperLogLog> distinct;
+};
+
+// Hash of field value for HyperLogLog. Integral float values are hashed
+// as integers, so that columns of different numeric types can be merged
+uint64_t hashFieldValue(const FieldValue &value);
+
+// Approximate percentiles and distinct count, serializable to Buffer and
+// mergeable with sketches of other RowSets
+class StatsSketch: public Napi::ObjectWrap<StatsSketch> {
+ public:
+#if NAPI_VERSION <= 5
+    // Constructor static variable
+    static Napi::FunctionReference constructor;
+#endif
+    static Napi::Object init(Napi::Env env, Napi::Object exports);
+
+    explicit StatsSketch(const Napi::CallbackInfo &info);
+
+    // N-API methods
+    Napi::Value quantile(const Napi::CallbackInfo &info);
+    Napi::Value distinct(const Napi::CallbackInfo &info);
+    Napi::Value merge(const Napi::CallbackInfo &info);
+    Napi::Value toBuffer(const Napi::CallbackInfo &info);
+    Napi::Value getCount(const Napi::CallbackInfo &info);
+    Napi::Value getMin(const Napi::CallbackInfo &info);
+    Napi::Value getMax(const Napi::CallbackInfo &info);
+    static Napi::Value fromBuffer(const Napi::CallbackInfo &info);
+
+ private:
+    SketchState mState;
+
+    // Throw Napi::Error for broken data
+    void deserialize(const Napi::Env &env, const Napi::Value &buffer,
+            SketchState *state);
+};
+
+}  // namespace griddb
+
+#endif  // STATSSKETCH_H
@@ -15,9 +15,18 @@
 */
 
 #include "Store.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <string>
 #include <map>
 #include <vector>
+#include "ExternalMemory.h"
+#include "FieldValue.h"
+#include "Metrics.h"
+#include "Tracing.h"
+#include "TopKMerger.h"
+#include "Watchdog.h"
 
 namespace griddb {
 
@@ -44,6 +53,18 @@ Napi::Object Store::init(Napi::Env env, Napi::Object exports) {
                 "createRowKeyPredicate", &Store::createRowKeyPredicate),
             InstanceMethod(
                 "fetchAll", &Store::fetchAll),
+            InstanceMethod(
+                "listContainerNames", &Store::listContainerNames),
+            InstanceMethod(
+                "putContainers", &Store::putContainers),
+            InstanceMethod(
+                "dropContainers", &Store::dropContainers),
+            InstanceMethod(
+                "setRowCache", &Store::setRowCache),
+            InstanceMethod(
+                "rowCacheStats", &Store::getRowCacheStats),
+            InstanceMethod(
+                "close", &Store::close),
             InstanceAccessor("partitionController",
                 &Store::getPartitionController,
                 &Store::setReadonlyAttribute)
@@ -61,19 +82,28 @@ Napi::Object Store::init(Napi::Env env, Napi::Object exports) {
 }
 
 Store::Store(const Napi::CallbackInfo &info) :
-        Napi::ObjectWrap<Store>(info) {
+        Napi::ObjectWrap<Store>(info), mStore(NULL),
+        mRowCache(new RowCache(ExternalMemory::account(info.Env()))) {
     Napi::Env env = info.Env();
-    if (info.Length() != 1 || !info[0].IsExternal()) {
+    if (info.Length() < 1 || info.Length() > 2 || !info[0].IsExternal()
+            || (info.Length() == 2 && !info[1].IsExternal())) {
         // Throw error
         THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
         return;
     }
 
     this->mStore = info[0].As<Napi::External<GSGridStore>>().Data();
+    Metrics::addGauge(GAUGE_OPEN_STORES, 1);
+    if (info.Length() == 2) {
+        // Handle pool for parallel operations, owned by this Store
+        mPool.reset(info[1].As<Napi::External<StorePool>>().Data());
+        mPartitionCache.reset(new PartitionCache(mPool));
+    }
 }
 
 Napi::Value Store::putContainer(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Store.putContainer", info);
     int length = info.Length();
     bool modifiable = false;
     ContainerInfo *containerInfo = NULL;
@@ -105,38 +135,59 @@ Napi::Value Store::putContainer(const Napi::CallbackInfo &info) {
     GSContainerInfo* gsInfo = containerInfo->gs_info();
     GSContainer* pContainer = NULL;
     // Create new gsContainer
+    int64_t startTime = Metrics::begin();
     GSResult ret = gsPutContainerGeneral(
             mStore, gsInfo->name, gsInfo, modifiable, &pContainer);
+    Metrics::record(METRIC_CONTAINER_DDL, gsInfo->type, startTime, ret);
     if (!GS_SUCCEEDED(ret)) {
         PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, mStore)
     }
 
-    // Create new Container object
+    if (modifiable) {
+        // Schema may be changed
+        mRowCache->invalidateContainer(gsInfo->name);
+    }
+
+    // Return promise object
+    deferred.Resolve(newContainer(env, pContainer, gsInfo));
+    return deferred.Promise();
+}
+
+// Create Container object sharing pool and row cache of this Store
+Napi::Value Store::newContainer(Napi::Env env, GSContainer *container,
+        GSContainerInfo *containerInfo) {
     Napi::EscapableHandleScope scope(env);
-    auto containerPtr = Napi::External<GSContainer>::New(env, pContainer);
-    auto containerInfoPtr = Napi::External<GSContainerInfo >::New(env, gsInfo);
-    Napi::Value containerWrapper;
+    auto containerPtr = Napi::External<GSContainer>::New(env, container);
+    auto containerInfoPtr =
+            Napi::External<GSContainerInfo >::New(env, containerInfo);
+    auto poolPtr = Napi::External<std::shared_ptr<StorePool> >::New(
+            env, &mPool);
+    auto cachePtr = Napi::External<std::shared_ptr<RowCache> >::New(
+            env, &mRowCache);
+    std::vector<napi_value> args = {containerPtr, containerInfoPtr, poolPtr,
+            cachePtr};
 #if NAPI_VERSION > 5
-    containerWrapper = scope.Escape(Util::getInstanceData(env, "Container")->
-            New({containerPtr, containerInfoPtr})).ToObject();
+    return scope.Escape(Util::getInstanceData(env, "Container")->
+            New(args)).ToObject();
 #else
-    containerWrapper = scope.Escape(Container::constructor.New(
-            {containerPtr, containerInfoPtr})).ToObject();
+    return scope.Escape(Container::constructor.New(args)).ToObject();
 #endif
-    // Return promise object
-    deferred.Resolve(containerWrapper);
-    return deferred.Promise();
 }
 
 Napi::Value Store::dropContainer(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Store.dropContainer", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
     if (info.Length() != 1 || !info[0].IsString()) {
         // Throw error
         PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mStore)
     }
     std::string name = info[0].As<Napi::String>().Utf8Value();
+    int64_t startTime = Metrics::begin();
     GSResult ret = gsDropContainer(mStore, name.c_str());
+    Metrics::record(METRIC_CONTAINER_DDL, METRIC_NO_CONTAINER_TYPE,
+            startTime, ret);
+    mRowCache->invalidateContainer(name);
 
     if (!GS_SUCCEEDED(ret)) {
         PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, mStore)
@@ -149,6 +200,7 @@ Napi::Value Store::dropContainer(const Napi::CallbackInfo &info) {
 
 Napi::Value Store::getContainer(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Store.getContainer", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
     if (info.Length() != 1 || !info[0].IsString()) {
         // Throw error
@@ -174,34 +226,41 @@ Napi::Value Store::getContainer(const Napi::CallbackInfo &info) {
         PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, mStore)
     }
 
-    // Create new Container object
-    Napi::EscapableHandleScope scope(env);
-    auto containerPtr = Napi::External<GSContainer>::New(env, pContainer);
-    auto containerInfoPtr =
-            Napi::External<GSContainerInfo >::New(env, &containerInfo);
-    Napi::Value containerWrapper;
-#if NAPI_VERSION > 5
-    containerWrapper = scope.Escape(Util::getInstanceData(env, "Container")->
-            New({ containerPtr, containerInfoPtr })).ToObject();
-#else
-    containerWrapper = scope.Escape(Container::constructor.New({ containerPtr,
-            containerInfoPtr })).ToObject();
-#endif
-
     // Return promise object
-    deferred.Resolve(containerWrapper);
+    deferred.Resolve(newContainer(env, pContainer, &containerInfo));
     return deferred.Promise();
 }
 
 Store::~Store() {
+    release();
+}
+
+void Store::release() {
     if (mStore != NULL) {
         gsCloseGridStore(&mStore, GS_TRUE);
         mStore = NULL;
+        Metrics::addGauge(GAUGE_OPEN_STORES, -1);
+    }
+    if (mPool) {
+        mPool->close();
+        mPartitionCache->close();
     }
 }
 
+/**
+ * @brief Close the GridStore handle and related Containers, Queries and
+ *   RowSets now instead of on GC. Pooled handles are closed as well,
+ *   handles of running workers are closed when they finish. Parallel
+ *   operations fail after this. Calling again does nothing
+ */
+Napi::Value Store::close(const Napi::CallbackInfo &info) {
+    release();
+    return info.Env().Undefined();
+}
+
 Napi::Value Store::getContainerInfo(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Store.getContainerInfo", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
     if (info.Length() != 1 || !info[0].IsString()) {
         // Throw error
@@ -241,6 +300,7 @@ Napi::Value Store::getContainerInfo(const Napi::CallbackInfo &info) {
 Napi::Value Store::getPartitionController(
         const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Store.partitionController", info);
     GSPartitionController* partitionController;
 
     GSResult ret = gsGetPartitionController(mStore, &partitionController);
@@ -254,12 +314,17 @@ Napi::Value Store::getPartitionController(
     Napi::EscapableHandleScope scope(env);
     auto controllerPtr = Napi::External<GSPartitionController>::New(info.Env(),
             partitionController);
+    std::vector<napi_value> args = {controllerPtr};
+    if (mPartitionCache) {
+        args.push_back(Napi::External<std::shared_ptr<PartitionCache> >::New(
+                env, &mPartitionCache));
+    }
 #if NAPI_VERSION > 5
     return scope.Escape(Util::getInstanceData(env, "PartitionController")->
-        New({controllerPtr})).ToObject();
+        New(args)).ToObject();
 #else
-    return scope.Escape(PartitionController::constructor.New( {
-        controllerPtr })).ToObject();
+    return scope.Escape(PartitionController::constructor.New(
+        args)).ToObject();
 #endif
 }
 
@@ -299,16 +364,310 @@ static void freeMemoryDataMultiPut(const char **listContainerName,
     }
 }
 
+// Rows of one container of Store.multiPut, copied from JS values
+struct PartitionPutContainer {
+    std::string name;
+    std::vector<std::vector<InputValue> > inputList;
+    std::vector<GSRow*> rowList;
+};
+
+// Containers of one Store.multiPut call, grouped by partition. Each slot
+// owns one pooled handle and puts its partition groups on its own thread.
+struct PartitionPutSlot {
+    GSGridStore *store;
+    // Container numbers of each partition
+    std::vector<std::vector<size_t> > groupList;
+    GSErrorDetail error;
+};
+
+// Partition lookup, container info lookup, row creation and put all run
+// off the JS thread, the JS thread only copies the input rows
+class PartitionMultiPutWorker : public Napi::AsyncWorker {
+ public:
+    PartitionMultiPutWorker(Napi::Env env, Napi::Promise::Deferred deferred,
+            std::shared_ptr<StorePool> pool,
+            std::shared_ptr<PartitionCache> partitionCache,
+            std::shared_ptr<RowCache> rowCache, size_t containerCount,
+            int concurrency) :
+            Napi::AsyncWorker(env), mContainerList(containerCount),
+            mDeferred(deferred), mPool(pool),
+            mPartitionCache(partitionCache), mRowCache(rowCache),
+            mConcurrency(concurrency) {
+    }
+
+    ~PartitionMultiPutWorker() {
+        for (size_t i = 0; i < mContainerList.size(); i++) {
+            std::vector<GSRow*> &rowList = mContainerList[i].rowList;
+            for (size_t j = 0; j < rowList.size(); j++) {
+                gsCloseRow(&rowList[j]);
+            }
+        }
+        for (size_t i = 0; i < mSlotList.size(); i++) {
+            mPool->release(mSlotList[i].store);
+        }
+    }
+
+    std::vector<PartitionPutContainer> mContainerList;
+
+ protected:
+    void Execute() override {
+        TraceSpan span("griddb.Store.multiPut.execute");
+        // Group containers by partition
+        std::map<int32_t, std::vector<size_t> > partitionMap;
+        for (size_t i = 0; i < mContainerList.size(); i++) {
+            int32_t partitionIndex;
+            GSResult ret = mPartitionCache->getPartitionIndex(
+                    mContainerList[i].name.c_str(), &partitionIndex);
+            if (!GS_SUCCEEDED(ret)) {
+                mError.capture(ret, NULL);
+                span.setResult(ret);
+                return;
+            }
+            partitionMap[partitionIndex].push_back(i);
+        }
+
+        size_t slotCount = std::min(static_cast<size_t>(mConcurrency),
+                partitionMap.size());
+        mSlotList.resize(slotCount);
+        for (size_t s = 0; s < slotCount; s++) {
+            mSlotList[s].store = NULL;
+            GSResult ret = mPool->acquire(&mSlotList[s].store);
+            if (!GS_SUCCEEDED(ret)) {
+                mError.capture(ret, NULL);
+                span.setResult(ret);
+                return;
+            }
+        }
+        size_t groupNo = 0;
+        for (std::map<int32_t, std::vector<size_t> >::iterator it =
+                partitionMap.begin(); it != partitionMap.end();
+                ++it, groupNo++) {
+            mSlotList[groupNo % slotCount].groupList.push_back(it->second);
+        }
+
+        StorePool::runParallel(mSlotList.size(), [this](size_t i) {
+            putSlot(&mSlotList[i]);
+        });
+        if (!span.active()) {
+            return;
+        }
+        int64_t rowCount = 0;
+        for (size_t i = 0; i < mSlotList.size(); i++) {
+            if (mSlotList[i].error.failed()) {
+                span.setResult(mSlotList[i].error.code);
+            }
+        }
+        for (size_t i = 0; i < mContainerList.size(); i++) {
+            rowCount += mContainerList[i].rowList.size();
+        }
+        span.setRows(rowCount);
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        invalidateRowCache();
+        if (mError.failed()) {
+            Napi::Object obj = GSException::New(env, mError);
+            mDeferred.Reject(Napi::Error(env, obj).Value());
+            return;
+        }
+        for (size_t i = 0; i < mSlotList.size(); i++) {
+            if (mSlotList[i].error.failed()) {
+                Napi::Object obj = GSException::New(env, mSlotList[i].error);
+                mDeferred.Reject(Napi::Error(env, obj).Value());
+                return;
+            }
+        }
+        mDeferred.Resolve(env.Null());
+    }
+
+    void OnError(const Napi::Error &e) override {
+        invalidateRowCache();
+        mDeferred.Reject(e.Value());
+    }
+
+ private:
+    Napi::Promise::Deferred mDeferred;
+    std::shared_ptr<StorePool> mPool;
+    std::shared_ptr<PartitionCache> mPartitionCache;
+    std::shared_ptr<RowCache> mRowCache;
+    int mConcurrency;
+    std::vector<PartitionPutSlot> mSlotList;
+    // Error before slots run
+    GSErrorDetail mError;
+
+    // Container.get may have cached rows read while putting
+    void invalidateRowCache() {
+        for (size_t i = 0; i < mContainerList.size(); i++) {
+            mRowCache->invalidateContainer(mContainerList[i].name);
+        }
+    }
+
+    // Create rows of container with the handle of slot
+    bool createRows(PartitionPutSlot *slot, PartitionPutContainer *target) {
+        GSContainerInfo containerInfo = GS_CONTAINER_INFO_INITIALIZER;
+        GSBool exists;
+        GSResult ret = gsGetContainerInfo(slot->store, target->name.c_str(),
+                &containerInfo, &exists);
+        if (!GS_SUCCEEDED(ret)) {
+            slot->error.capture(ret, slot->store);
+            return false;
+        }
+        if (!exists) {
+            slot->error.capture("Container not found: " + target->name);
+            return false;
+        }
+        target->rowList.reserve(target->inputList.size());
+        for (size_t k = 0; k < target->inputList.size(); k++) {
+            const std::vector<InputValue> &input = target->inputList[k];
+            if (input.size() != containerInfo.columnCount) {
+                slot->error.capture(
+                        "Num row is different with container info");
+                return false;
+            }
+            GSRow *row;
+            ret = gsCreateRowByStore(slot->store, &containerInfo, &row);
+            if (!GS_SUCCEEDED(ret)) {
+                slot->error.capture(ret, slot->store);
+                return false;
+            }
+            target->rowList.push_back(row);
+            for (size_t j = 0; j < input.size(); j++) {
+                const char *error = writeInputValue(input[j], row,
+                        static_cast<int>(j),
+                        containerInfo.columnInfoList[j].type, &ret);
+                if (error != NULL) {
+                    slot->error.capture(error);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void putSlot(PartitionPutSlot *slot) {
+        for (size_t i = 0; i < slot->groupList.size(); i++) {
+            const std::vector<size_t> &group = slot->groupList[i];
+            std::vector<GSContainerRowEntry> entryList;
+            for (size_t n = 0; n < group.size(); n++) {
+                PartitionPutContainer &target = mContainerList[group[n]];
+                if (!createRows(slot, &target)) {
+                    return;
+                }
+                GSContainerRowEntry entry =
+                        GS_CONTAINER_ROW_ENTRY_INITIALIZER;
+                entry.containerName = target.name.c_str();
+                entry.rowList = (void* const*) target.rowList.data();
+                entry.rowCount = target.rowList.size();
+                entryList.push_back(entry);
+            }
+            int64_t startTime = Metrics::begin();
+            GSResult ret = gsPutMultipleContainerRows(slot->store,
+                    entryList.data(), entryList.size());
+            Metrics::record(METRIC_PUT_MULTIPLE_CONTAINER_ROWS,
+                    METRIC_NO_CONTAINER_TYPE, startTime, ret);
+            if (!GS_SUCCEEDED(ret)) {
+                slot->error.capture(ret, slot->store);
+                return;
+            }
+            for (size_t j = 0; j < entryList.size(); j++) {
+                Metrics::add(COUNTER_ROWS_WRITTEN, entryList[j].rowCount);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Put rows of multiple containers, one gsPutMultipleContainerRows
+ *   call per partition. Input rows are copied on the JS thread, everything
+ *   else runs off the JS thread with partitions spread over pooled handles.
+ */
+Napi::Value Store::multiPutByPartition(Napi::Env env,
+        Napi::Promise::Deferred deferred, Napi::Object objNapi,
+        int concurrency, PhaseTimer *timer) {
+    if (!mPool) {
+        PROMISE_REJECT_WITH_STRING(deferred, env,
+                "Partition aware mode is not available", mStore)
+    }
+    if (mStore == NULL) {
+        PROMISE_REJECT_WITH_STRING(deferred, env, "Store is closed", NULL)
+    }
+    Napi::Array objProp = objNapi.GetPropertyNames();
+    size_t containerCount = objProp.Length();
+    PartitionMultiPutWorker *worker = new PartitionMultiPutWorker(env,
+            deferred, mPool, mPartitionCache, mRowCache, containerCount,
+            concurrency);
+
+    for (size_t i = 0; i < containerCount; i++) {
+        PartitionPutContainer &target = worker->mContainerList[i];
+        Napi::Value name = objProp[i];
+        target.name = name.ToString().Utf8Value();
+        Napi::Value rows = objNapi.Get(target.name);
+        if (!rows.IsArray()) {
+            delete worker;
+            PROMISE_REJECT_WITH_STRING(deferred, env,
+                    "Expected an array as rowList", mStore)
+        }
+        Napi::Array rowArray = rows.As<Napi::Array>();
+        uint32_t rowCount = rowArray.Length();
+        target.inputList.resize(rowCount);
+        for (uint32_t k = 0; k < rowCount; k++) {
+            Napi::Value oneValue = rowArray[k];
+            if (!oneValue.IsArray()) {
+                delete worker;
+                PROMISE_REJECT_WITH_STRING(deferred, env,
+                        "Expected an array as rowList", mStore)
+            }
+            Napi::Array oneRow = oneValue.As<Napi::Array>();
+            std::vector<InputValue> &input = target.inputList[k];
+            input.resize(oneRow.Length());
+            for (uint32_t j = 0; j < oneRow.Length(); j++) {
+                readInputValue(oneRow.Get(j), &input[j]);
+            }
+        }
+    }
+    timer->enter(PHASE_EXECUTE);
+    worker->Queue();
+    timer->finish(deferred.Promise());
+    return deferred.Promise();
+}
+
 Napi::Value Store::multiPut(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Store.multiPut", info);
     size_t containerCount;
     GSResult ret;
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-    if (info.Length() != 1 || !info[0].IsObject()) {
+    TraceSpan span("griddb.Store.multiPut");
+    if ((info.Length() != 1 && info.Length() != 2) || !info[0].IsObject()
+            || (info.Length() == 2 && !info[1].IsObject())) {
         PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mStore)
     }
 
+    PhaseTimer timer(CALL_STORE_MULTI_PUT);
     Napi::Object objNapi = info[0].As<Napi::Object>();
+    if (mRowCache->enabled()) {
+        Napi::Array names = objNapi.GetPropertyNames();
+        for (uint32_t i = 0; i < names.Length(); i++) {
+            mRowCache->invalidateContainer(
+                    names.Get(i).ToString().Utf8Value());
+        }
+    }
+    if (info.Length() == 2) {
+        Napi::Object options = info[1].As<Napi::Object>();
+        bool partitionAware = false;
+        OPTIONAL_MEMBER_BOOL(partitionAware, "partitionAware", options)
+        int concurrency = DEFAULT_POOL_CONCURRENCY;
+        OPTIONAL_MEMBER_INT32(concurrency, "concurrency", options)
+        if (concurrency < 1) {
+            PROMISE_REJECT_WITH_STRING(deferred, env,
+                    "concurrency should be positive", mStore)
+        }
+        if (partitionAware) {
+            return multiPutByPartition(env, deferred, objNapi, concurrency,
+                    &timer);
+        }
+    }
     Napi::Array objProp = objNapi.GetPropertyNames();
     containerCount = objProp.Length();
     GSContainer *containerPtr;
@@ -409,8 +768,22 @@ Napi::Value Store::multiPut(const Napi::CallbackInfo &info) {
         entryList[i].rowCount = listRowContainerCount[i];
         entryList[i].rowList = (void* const*)allRowList[i];
     }
+    timer.enter(PHASE_EXECUTE);
+    int64_t startTime = Metrics::begin();
     ret = gsPutMultipleContainerRows(mStore, entryList, containerCount);
+    Metrics::record(METRIC_PUT_MULTIPLE_CONTAINER_ROWS,
+            METRIC_NO_CONTAINER_TYPE, startTime, ret);
+    span.setResult(ret);
+    if (GS_SUCCEEDED(ret)) {
+        int64_t rowCount = 0;
+        for (size_t i = 0; i < containerCount; i++) {
+            rowCount += entryList[i].rowCount;
+        }
+        Metrics::add(COUNTER_ROWS_WRITTEN, rowCount);
+        span.setRows(rowCount);
+    }
     // Free memory
+    timer.enter(PHASE_CLEANUP);
     freeMemoryDataMultiPut(listContainerName, listRowContainerCount,
                 entryList, allRowList, containerCount);
     if (!GS_SUCCEEDED(ret)) {
@@ -418,12 +791,14 @@ Napi::Value Store::multiPut(const Napi::CallbackInfo &info) {
     }
     // Return promise object
     deferred.Resolve(env.Null());
+    timer.finish(deferred.Promise());
     return deferred.Promise();
 }
 
 // Create RowKey Predicate
 Napi::Value Store::createRowKeyPredicate(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Store.createRowKeyPredicate", info);
     if (info.Length() != 1 || !info[0].IsNumber()) {
         THROW_EXCEPTION_WITH_STR(env, "Wrong arguments\n", mStore)
         return env.Null();
@@ -477,7 +852,9 @@ static void freeMemoryDataSetMulti(
 // Function set multi montainer numList support for method multiGet
 static bool setMultiContainerNumList(Napi::Env env, GSGridStore *mStore,
                 const GSRowKeyPredicateEntry* const * predicateList,
-                int length, int **colNumList, GSType*** typeList) {
+                int length, int **colNumList, GSType*** typeList,
+                std::vector<std::shared_ptr<const ContainerSchema> >
+                *schemaList = NULL) {
     GSResult ret;
     GSBool bExists;
     GSContainerInfo containerInfo;
@@ -508,6 +885,10 @@ static bool setMultiContainerNumList(Napi::Env env, GSGridStore *mStore,
         for (int j = 0; j < (*colNumList)[i]; j++) {
             (*typeList)[i][j] = containerInfo.columnInfoList[j].type;
         }
+        if (schemaList) {
+            schemaList->push_back(ContainerSchema::intern(&containerInfo,
+                    ExternalMemory::account(env)));
+        }
     }
     return true;
 }
@@ -545,13 +926,28 @@ static void freeMemoryDataMultiGet(GSRowKeyPredicateEntry *predicate,
     }
 }
 
-// Multi get container
+// Multi get container. With options {orderBy, k}, resolve the first k rows
+// of all containers in order instead of rows per container
 Napi::Value Store::multiGet(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Store.multiGet", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-    if (info.Length() != 1 || !info[0].IsObject()) {
+    if (info.Length() < 1 || info.Length() > 2 || !info[0].IsObject()) {
         PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mStore)
     }
+    PhaseTimer timer(CALL_STORE_MULTI_GET);
+    TraceSpan span("griddb.Store.multiGet");
+    bool topK = info.Length() == 2 && !info[1].IsUndefined();
+    TopKMerger merger;
+    std::vector<std::shared_ptr<const ContainerSchema> > schemaList;
+    std::map<std::string, std::shared_ptr<const ContainerSchema> > schemaMap;
+    if (topK) {
+        try {
+            merger.setOptions(env, info[1]);
+        } catch (const Napi::Error &e) {
+            PROMISE_REJECT_WITH_ERROR(deferred, e)
+        }
+    }
     const GSContainerRowEntry *outEntryList;
     size_t outEntryCount;
     Napi::Object objNapi = info[0].As<Napi::Object>();
@@ -579,7 +975,8 @@ Napi::Value Store::multiGet(const Napi::CallbackInfo &info) {
     int *colNumList;
     GSType** typeList;
     bool setNumList = setMultiContainerNumList(env, mStore, predicateList,
-                containerCount, &colNumList, &typeList);
+                containerCount, &colNumList, &typeList,
+                topK ? &schemaList : NULL);
     if (!setNumList) {
         freeMemoryDataMultiGet(predEntryValueList, colNumList, typeList,
                     containerCount,
@@ -594,15 +991,64 @@ Napi::Value Store::multiGet(const Napi::CallbackInfo &info) {
         for (int j = 0 ; j < colNumList[i]; j++) {
             dict[strContainerName].push_back(typeList[i][j]);
         }
+        if (topK) {
+            schemaMap[strContainerName] = schemaList[i];
+        }
     }
+    timer.enter(PHASE_EXECUTE);
+    int64_t startTime = Metrics::begin();
     GSResult ret = gsGetMultipleContainerRows(mStore, predicateList,
                 containerCount, &outEntryList, &outEntryCount);
+    Metrics::record(METRIC_GET_MULTIPLE_CONTAINER_ROWS,
+            METRIC_NO_CONTAINER_TYPE, startTime, ret);
+    span.setResult(ret);
     if (!GS_SUCCEEDED(ret)) {
         freeMemoryDataMultiGet(predEntryValueList, colNumList, typeList,
                     containerCount,
                     const_cast<GSContainerRowEntry**>(&outEntryList));
         PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, mStore)
     }
+    int64_t rowCount = 0;
+    for (size_t i = 0; i < outEntryCount; i++) {
+        rowCount += outEntryList[i].rowCount;
+    }
+    Metrics::add(COUNTER_ROWS_READ, rowCount);
+    span.setRows(rowCount);
+
+    timer.enter(PHASE_BUILD);
+    if (topK) {
+        Napi::Value rows;
+        try {
+            for (int i = 0; i < static_cast<int>(outEntryCount) &&
+                    GS_SUCCEEDED(ret); i++) {
+                merger.setSource(env,
+                        schemaMap.at(outEntryList[i].containerName));
+                for (size_t j = 0; j < outEntryList[i].rowCount &&
+                        GS_SUCCEEDED(ret); j++) {
+                    ret = merger.offer(reinterpret_cast<GSRow *>(
+                            outEntryList[i].rowList[j]));
+                }
+            }
+            if (GS_SUCCEEDED(ret)) {
+                rows = merger.toArray(env);
+            }
+        } catch (const Napi::Error &e) {
+            freeMemoryDataMultiGet(predEntryValueList, colNumList,
+                    typeList, containerCount,
+                    const_cast<GSContainerRowEntry**>(&outEntryList));
+            PROMISE_REJECT_WITH_ERROR(deferred, e)
+        }
+        timer.enter(PHASE_CLEANUP);
+        freeMemoryDataMultiGet(predEntryValueList, colNumList, typeList,
+                containerCount,
+                const_cast<GSContainerRowEntry**>(&outEntryList));
+        if (!GS_SUCCEEDED(ret)) {
+            PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, mStore)
+        }
+        deferred.Resolve(rows);
+        timer.finish(deferred.Promise());
+        return deferred.Promise();
+    }
 
     // Loop get data
     Napi::Object objResult = Napi::Object::New(env);
@@ -629,22 +1075,27 @@ Napi::Value Store::multiGet(const Napi::CallbackInfo &info) {
         objResult.Set(outEntryList[i].containerName, tmpArr);
     }
     // Free memory
+    timer.enter(PHASE_CLEANUP);
     freeMemoryDataMultiGet(predEntryValueList, colNumList, typeList,
                 containerCount,
                 const_cast<GSContainerRowEntry**>(&outEntryList));
     // Return promise object
     deferred.Resolve(objResult);
+    timer.finish(deferred.Promise());
     return deferred.Promise();
 }
 
 Napi::Value Store::fetchAll(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("Store.fetchAll", info);
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
     if (info.Length() != 1 && !(info[0].IsArray() || info[0].IsNull())) {
         // Throw error
         PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mStore)
     }
 
+    PhaseTimer timer(CALL_STORE_FETCH_ALL);
+    TraceSpan span("griddb.Store.fetchAll");
     GSResult ret;
     size_t queryCount;
     GSQuery **queryList;
@@ -667,13 +1118,19 @@ Napi::Value Store::fetchAll(const Napi::CallbackInfo &info) {
                 ::Unwrap(tmpVal.As<Napi::Object>());
         queryList[i] = query->gsPtr();
     }
+    timer.enter(PHASE_EXECUTE);
+    int64_t startTime = Metrics::begin();
     ret = gsFetchAll(mStore, (GSQuery* const*)queryList, queryCount);
+    Metrics::record(METRIC_FETCH_ALL, METRIC_NO_CONTAINER_TYPE, startTime, ret);
+    span.setResult(ret);
     // Free memory
+    timer.enter(PHASE_CLEANUP);
     delete [] queryList;
     if (!GS_SUCCEEDED(ret)) {
         PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, mStore)
     }
     deferred.Resolve(env.Null());
+    timer.finish(deferred.Promise());
     return deferred.Promise();
 }
 
@@ -683,5 +1140,567 @@ void Store::setReadonlyAttribute(const Napi::CallbackInfo &info,
     THROW_EXCEPTION_WITH_STR(env, "Can't set read only attribute", mStore)
 }
 
-}  // namespace griddb
+/**
+ * @brief Match name with LIKE pattern ('%' any string, '_' any character,
+ *   '\' escape), ignoring ASCII case as container names do.
+ */
+static bool matchPattern(const char *pattern, const char *name) {
+    while (*pattern != '\0') {
+        if (*pattern == '%') {
+            while (*pattern == '%') {
+                pattern++;
+            }
+            if (*pattern == '\0') {
+                return true;
+            }
+            for (; *name != '\0'; name++) {
+                if (matchPattern(pattern, name)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        if (*name == '\0') {
+            return false;
+        }
+        if (*pattern == '\\' && pattern[1] != '\0') {
+            pattern++;
+        } else if (*pattern == '_') {
+            pattern++;
+            name++;
+            continue;
+        }
+        if (tolower(static_cast<unsigned char>(*pattern))
+                != tolower(static_cast<unsigned char>(*name))) {
+            return false;
+        }
+        pattern++;
+        name++;
+    }
+    return *name == '\0';
+}
+
+// One handle of a container name listing, used by one thread
+struct ContainerNameSlot {
+    GSGridStore *store;
+    GSPartitionController *controller;
+    GSErrorDetail error;
+};
+
+// List container names of a range of partitions, partitions are read in
+// parallel with one pooled handle per thread.
+class ContainerNamesWorker : public Napi::AsyncWorker {
+ public:
+    ContainerNamesWorker(Napi::Env env, Napi::Promise::Deferred deferred,
+            std::shared_ptr<StorePool> pool, int32_t startPartition,
+            int32_t endPartition, int64_t pageSize,
+            const std::string &pattern) :
+            Napi::AsyncWorker(env), mDeferred(deferred), mPool(pool),
+            mStartPartition(startPartition), mEndPartition(endPartition),
+            mPartitionCount(0), mPageSize(pageSize), mPattern(pattern),
+            mNextPartition(startPartition) {
+    }
+
+    ~ContainerNamesWorker() {
+        for (size_t i = 0; i < mSlotList.size(); i++) {
+            if (mSlotList[i].controller != NULL) {
+                gsClosePartitionController(&mSlotList[i].controller);
+            }
+            mPool->release(mSlotList[i].store);
+        }
+    }
+
+    std::vector<ContainerNameSlot> mSlotList;
+
+ protected:
+    void Execute() override {
+        for (size_t i = 0; i < mSlotList.size(); i++) {
+            GSResult ret = gsGetPartitionController(mSlotList[i].store,
+                    &mSlotList[i].controller);
+            if (!GS_SUCCEEDED(ret)) {
+                mSlotList[i].error.capture(ret, mSlotList[i].store);
+                return;
+            }
+        }
+        GSResult ret = gsGetPartitionCount(mSlotList[0].controller,
+                &mPartitionCount);
+        if (!GS_SUCCEEDED(ret)) {
+            mSlotList[0].error.capture(ret, mSlotList[0].controller);
+            return;
+        }
+        mEndPartition = std::min(mEndPartition, mPartitionCount);
+        if (mStartPartition >= mEndPartition) {
+            return;
+        }
+        mNameList.resize(mEndPartition - mStartPartition);
+        StorePool::runParallel(mSlotList.size(), [this](size_t i) {
+            listSlot(&mSlotList[i]);
+        });
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        for (size_t i = 0; i < mSlotList.size(); i++) {
+            if (mSlotList[i].error.failed()) {
+                Napi::Object obj = GSException::New(env, mSlotList[i].error);
+                mDeferred.Reject(Napi::Error(env, obj).Value());
+                return;
+            }
+        }
+        size_t count = 0;
+        for (size_t i = 0; i < mNameList.size(); i++) {
+            count += mNameList[i].size();
+        }
+        Napi::Array names = Napi::Array::New(env, count);
+        uint32_t index = 0;
+        for (size_t i = 0; i < mNameList.size(); i++) {
+            for (size_t j = 0; j < mNameList[i].size(); j++) {
+                names.Set(index++, Napi::String::New(env, mNameList[i][j]));
+            }
+        }
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("partitionCount", Napi::Number::New(env, mPartitionCount));
+        result.Set("names", names);
+        mDeferred.Resolve(result);
+    }
+
+ private:
+    Napi::Promise::Deferred mDeferred;
+    std::shared_ptr<StorePool> mPool;
+    int32_t mStartPartition;
+    int32_t mEndPartition;
+    int32_t mPartitionCount;
+    int64_t mPageSize;
+    std::string mPattern;
+    std::atomic<int32_t> mNextPartition;
+    std::vector<std::vector<std::string> > mNameList;
+
+    void listSlot(ContainerNameSlot *slot) {
+        for (int32_t partition = mNextPartition++;
+                partition < mEndPartition; partition = mNextPartition++) {
+            std::vector<std::string> &nameList =
+                    mNameList[partition - mStartPartition];
+            int64_t start = 0;
+            while (true) {
+                const GSChar *const *stringList;
+                size_t size;
+                int64_t limit = mPageSize;
+                GSResult ret = gsGetPartitionContainerNames(slot->controller,
+                        partition, start, &limit, &stringList, &size);
+                if (!GS_SUCCEEDED(ret)) {
+                    slot->error.capture(ret, slot->controller);
+                    // Let other threads stop too
+                    mNextPartition = mEndPartition;
+                    return;
+                }
+                for (size_t i = 0; i < size; i++) {
+                    if (mPattern.empty()
+                            || matchPattern(mPattern.c_str(), stringList[i])) {
+                        nameList.push_back(stringList[i]);
+                    }
+                }
+                if (static_cast<int64_t>(size) < mPageSize) {
+                    break;
+                }
+                start += size;
+            }
+        }
+    }
+};
+
+/**
+ * List container names of partitions [start, end) off the JS thread.
+ * Used by Store.listContainers() in griddb-node-api.js.
+ * options: pattern (LIKE pattern), concurrency, pageSize
+ * Resolves {partitionCount, names}.
+ */
+Napi::Value Store::listContainerNames(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("Store.listContainerNames", info);
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    if (info.Length() != 3 || !info[0].IsNumber() || !info[1].IsNumber()
+            || !info[2].IsObject()) {
+        PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mStore)
+    }
+    if (!mPool) {
+        PROMISE_REJECT_WITH_STRING(deferred, env,
+                "Parallel listing is not available", mStore)
+    }
+    if (mStore == NULL) {
+        PROMISE_REJECT_WITH_STRING(deferred, env, "Store is closed", NULL)
+    }
+    int32_t startPartition = info[0].As<Napi::Number>().Int32Value();
+    int32_t endPartition = info[1].As<Napi::Number>().Int32Value();
+    Napi::Object options = info[2].As<Napi::Object>();
+    std::string pattern;
+    OPTIONAL_MEMBER_STRING(pattern, "pattern", options)
+    int concurrency = DEFAULT_POOL_CONCURRENCY;
+    OPTIONAL_MEMBER_INT32(concurrency, "concurrency", options)
+    int pageSize = DEFAULT_CONTAINER_NAME_PAGE_SIZE;
+    OPTIONAL_MEMBER_INT32(pageSize, "pageSize", options)
+    if (startPartition < 0 || concurrency < 1 || pageSize < 1) {
+        PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mStore)
+    }
+
+    ContainerNamesWorker *worker = new ContainerNamesWorker(env, deferred,
+            mPool, startPartition, endPartition, pageSize, pattern);
+    int slotCount = std::max(1, std::min(concurrency,
+            endPartition - startPartition));
+    worker->mSlotList.resize(slotCount);
+    for (int i = 0; i < slotCount; i++) {
+        worker->mSlotList[i].store = NULL;
+        worker->mSlotList[i].controller = NULL;
+        GSResult ret = mPool->acquire(&worker->mSlotList[i].store);
+        if (!GS_SUCCEEDED(ret)) {
+            delete worker;
+            PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, NULL)
+        }
+    }
+    worker->Queue();
+    return deferred.Promise();
+}
+
+// One container of Store.putContainers or Store.dropContainers
+struct ContainerDdlItem {
+    std::string name;
+    std::shared_ptr<const ContainerSchema> schema;  // Empty when dropping
+    GSErrorDetail error;
+};
+
+// Create or drop containers in parallel, one pooled handle per thread.
+// Each container gets its own result, a failure doesn't stop the others.
+class ContainerDdlWorker : public Napi::AsyncWorker {
+ public:
+    ContainerDdlWorker(Napi::Env env, Napi::Promise::Deferred deferred,
+            std::shared_ptr<StorePool> pool,
+            std::shared_ptr<RowCache> rowCache, bool modifiable) :
+            Napi::AsyncWorker(env), mDeferred(deferred), mPool(pool),
+            mRowCache(rowCache), mModifiable(modifiable), mNextItem(0) {
+    }
+
+    ~ContainerDdlWorker() {
+        for (size_t i = 0; i < mStoreList.size(); i++) {
+            mPool->release(mStoreList[i]);
+        }
+    }
+
+    std::vector<ContainerDdlItem> mItemList;
+    std::vector<GSGridStore*> mStoreList;
+
+ protected:
+    void Execute() override {
+        StorePool::runParallel(mStoreList.size(), [this](size_t i) {
+            runSlot(mStoreList[i]);
+        });
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        invalidateRowCache();
+        Napi::Array result = Napi::Array::New(env, mItemList.size());
+        for (size_t i = 0; i < mItemList.size(); i++) {
+            Napi::Object item = Napi::Object::New(env);
+            item.Set("name", Napi::String::New(env, mItemList[i].name));
+            if (mItemList[i].error.failed()) {
+                item.Set("error", Napi::Error(env, GSException::New(env,
+                        mItemList[i].error)).Value());
+            } else {
+                item.Set("error", env.Null());
+            }
+            result.Set(static_cast<uint32_t>(i), item);
+        }
+        mDeferred.Resolve(result);
+    }
+
+    void OnError(const Napi::Error &e) override {
+        invalidateRowCache();
+        mDeferred.Reject(e.Value());
+    }
+
+ private:
+    Napi::Promise::Deferred mDeferred;
+    std::shared_ptr<StorePool> mPool;
+    std::shared_ptr<RowCache> mRowCache;
+    bool mModifiable;
+    std::atomic<size_t> mNextItem;
+
+    // Container.get may have cached rows of dropped or altered containers
+    // while running
+    void invalidateRowCache() {
+        for (size_t i = 0; i < mItemList.size(); i++) {
+            if (!mItemList[i].schema || mModifiable) {
+                mRowCache->invalidateContainer(mItemList[i].name);
+            }
+        }
+    }
+
+    void runSlot(GSGridStore *store) {
+        for (size_t i = mNextItem++; i < mItemList.size(); i = mNextItem++) {
+            ContainerDdlItem &item = mItemList[i];
+            GSResult ret;
+            if (item.schema) {
+                GSContainerInfo containerInfo;
+                item.schema->toContainerInfo(item.name.c_str(),
+                        &containerInfo);
+                GSContainer *container = NULL;
+                int64_t startTime = Metrics::begin();
+                ret = gsPutContainerGeneral(store, item.name.c_str(),
+                        &containerInfo, mModifiable, &container);
+                Metrics::record(METRIC_CONTAINER_DDL, containerInfo.type,
+                        startTime, ret);
+                if (GS_SUCCEEDED(ret) && container != NULL) {
+                    gsCloseContainer(&container, GS_FALSE);
+                }
+            } else {
+                int64_t startTime = Metrics::begin();
+                ret = gsDropContainer(store, item.name.c_str());
+                Metrics::record(METRIC_CONTAINER_DDL, METRIC_NO_CONTAINER_TYPE,
+                        startTime, ret);
+            }
+            if (!GS_SUCCEEDED(ret)) {
+                item.error.capture(ret, store);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Acquire pooled handles for worker, at most one per item.
+ * @return Result of StorePool::acquire()
+ */
+static GSResult acquireStoreList(StorePool *pool, int concurrency,
+        size_t itemCount, std::vector<GSGridStore*> *storeList) {
+    size_t count = std::min(static_cast<size_t>(concurrency), itemCount);
+    for (size_t i = 0; i < count; i++) {
+        GSGridStore *store;
+        GSResult ret = pool->acquire(&store);
+        if (!GS_SUCCEEDED(ret)) {
+            return ret;
+        }
+        storeList->push_back(store);
+    }
+    return GS_RESULT_OK;
+}
+
+/**
+ * Create many containers off the JS thread.
+ * infos: array of ContainerInfo, or of {name, info} to create container
+ * "name" with the schema of ContainerInfo "info". Containers created from
+ * the same ContainerInfo share one copy of its schema.
+ * options: concurrency, modifiable
+ * Resolves [{name, error}], error is null on success.
+ */
+Napi::Value Store::putContainers(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("Store.putContainers", info);
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    if (info.Length() < 1 || info.Length() > 2 || !info[0].IsArray()
+            || (info.Length() == 2 && !info[1].IsObject())) {
+        PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mStore)
+    }
+    if (!mPool) {
+        PROMISE_REJECT_WITH_STRING(deferred, env,
+                "Parallel operation is not available", mStore)
+    }
+    if (mStore == NULL) {
+        PROMISE_REJECT_WITH_STRING(deferred, env, "Store is closed", NULL)
+    }
+    int concurrency = DEFAULT_POOL_CONCURRENCY;
+    bool modifiable = false;
+    if (info.Length() == 2) {
+        Napi::Object options = info[1].As<Napi::Object>();
+        OPTIONAL_MEMBER_INT32(concurrency, "concurrency", options)
+        OPTIONAL_MEMBER_BOOL(modifiable, "modifiable", options)
+    }
+    if (concurrency < 1) {
+        PROMISE_REJECT_WITH_STRING(deferred, env,
+                "concurrency should be positive", mStore)
+    }
 
+    Napi::Array infoList = info[0].As<Napi::Array>();
+    ContainerDdlWorker *worker = new ContainerDdlWorker(env, deferred,
+            mPool, mRowCache, modifiable);
+    worker->mItemList.resize(infoList.Length());
+    std::map<ContainerInfo*, std::shared_ptr<const ContainerSchema> >
+            schemaMap;
+    for (uint32_t i = 0; i < infoList.Length(); i++) {
+        Napi::Value value = infoList[i];
+        if (!value.IsObject()) {
+            delete worker;
+            PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments",
+                    mStore)
+        }
+        Napi::Object obj = value.As<Napi::Object>();
+        ContainerInfo *containerInfo;
+        bool named = obj.Has("info");
+        if (named) {
+            if (!obj.Get("name").IsString() || !obj.Get("info").IsObject()) {
+                delete worker;
+                PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments",
+                        mStore)
+            }
+            worker->mItemList[i].name =
+                    obj.Get("name").As<Napi::String>().Utf8Value();
+            containerInfo = Napi::ObjectWrap<ContainerInfo>::Unwrap(
+                    obj.Get("info").As<Napi::Object>());
+        } else {
+            containerInfo = Napi::ObjectWrap<ContainerInfo>::Unwrap(obj);
+        }
+        if (containerInfo == NULL) {
+            // Not a ContainerInfo, reject instead of throwing unwrap error
+            env.GetAndClearPendingException();
+            delete worker;
+            PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments",
+                    mStore)
+        }
+        if (!named && containerInfo->gs_info()->name) {
+            worker->mItemList[i].name = containerInfo->gs_info()->name;
+        }
+        // Schemas don't keep triggers, create such containers with
+        // putContainer instead of creating them without triggers
+        if (containerInfo->gs_info()->triggerInfoCount > 0) {
+            delete worker;
+            PROMISE_REJECT_WITH_STRING(deferred, env,
+                    "Triggers are not supported by putContainers, "
+                    "use putContainer", mStore)
+        }
+        std::shared_ptr<const ContainerSchema> &schema =
+                schemaMap[containerInfo];
+        if (!schema) {
+            schema = ContainerSchema::intern(containerInfo->gs_info(),
+                    ExternalMemory::account(env));
+        }
+        worker->mItemList[i].schema = schema;
+        if (modifiable) {
+            mRowCache->invalidateContainer(worker->mItemList[i].name);
+        }
+    }
+
+    GSResult ret = acquireStoreList(mPool.get(), concurrency,
+            worker->mItemList.size(), &worker->mStoreList);
+    if (!GS_SUCCEEDED(ret)) {
+        delete worker;
+        PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, NULL)
+    }
+    worker->Queue();
+    return deferred.Promise();
+}
+
+/**
+ * Drop many containers off the JS thread.
+ * options: concurrency
+ * Resolves [{name, error}], error is null on success.
+ */
+Napi::Value Store::dropContainers(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    BlockingWatch watch("Store.dropContainers", info);
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    if (info.Length() < 1 || info.Length() > 2 || !info[0].IsArray()
+            || (info.Length() == 2 && !info[1].IsObject())) {
+        PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments", mStore)
+    }
+    if (!mPool) {
+        PROMISE_REJECT_WITH_STRING(deferred, env,
+                "Parallel operation is not available", mStore)
+    }
+    if (mStore == NULL) {
+        PROMISE_REJECT_WITH_STRING(deferred, env, "Store is closed", NULL)
+    }
+    int concurrency = DEFAULT_POOL_CONCURRENCY;
+    if (info.Length() == 2) {
+        Napi::Object options = info[1].As<Napi::Object>();
+        OPTIONAL_MEMBER_INT32(concurrency, "concurrency", options)
+    }
+    if (concurrency < 1) {
+        PROMISE_REJECT_WITH_STRING(deferred, env,
+                "concurrency should be positive", mStore)
+    }
+
+    Napi::Array nameList = info[0].As<Napi::Array>();
+    ContainerDdlWorker *worker = new ContainerDdlWorker(env, deferred,
+            mPool, mRowCache, false);
+    worker->mItemList.resize(nameList.Length());
+    for (uint32_t i = 0; i < nameList.Length(); i++) {
+        Napi::Value value = nameList[i];
+        if (!value.IsString()) {
+            delete worker;
+            PROMISE_REJECT_WITH_STRING(deferred, env, "Wrong arguments",
+                    mStore)
+        }
+        worker->mItemList[i].name = value.As<Napi::String>().Utf8Value();
+        mRowCache->invalidateContainer(worker->mItemList[i].name);
+    }
+
+    GSResult ret = acquireStoreList(mPool.get(), concurrency,
+            worker->mItemList.size(), &worker->mStoreList);
+    if (!GS_SUCCEEDED(ret)) {
+        delete worker;
+        PROMISE_REJECT_WITH_ERROR_CODE(deferred, env, ret, NULL)
+    }
+    worker->Queue();
+    return deferred.Promise();
+}
+
+/**
+ * @brief Configure read-through cache of rows read by Container.get of
+ *   Containers of this Store. Rows are invalidated by put, multiPut and
+ *   remove through this Store
+ * @param info[0] Object of
+ *   maxBytes: size cap of cached rows, 0 disables the cache
+ *   ttl: time to live in milliseconds, 0 for no expiry (default)
+ */
+Napi::Value Store::setRowCache(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() != 1 || !info[0].IsObject()) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", mStore)
+        return env.Undefined();
+    }
+    Napi::Object options = info[0].As<Napi::Object>();
+    Napi::Value maxBytes = options.Get("maxBytes");
+    Napi::Value ttl = options.Get("ttl");
+    if (!maxBytes.IsNumber() || maxBytes.As<Napi::Number>().DoubleValue() < 0
+            || !(ttl.IsUndefined() || (ttl.IsNumber() &&
+            ttl.As<Napi::Number>().DoubleValue() >= 0))) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", mStore)
+        return env.Undefined();
+    }
+    mRowCache->configure(
+            static_cast<size_t>(maxBytes.As<Napi::Number>().Int64Value()),
+            ttl.IsUndefined() ? 0 : ttl.As<Napi::Number>().Int64Value());
+    return env.Undefined();
+}
+
+/**
+ * @brief Counters of row cache
+ * @return {hits, misses, hitRatio, evictions, expirations, invalidations,
+ *   entries, bytes, maxBytes, ttl}
+ */
+Napi::Value Store::getRowCacheStats(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    RowCacheStats stats = mRowCache->stats();
+    uint64_t lookups = stats.hits + stats.misses;
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("hits", Napi::Number::New(env,
+            static_cast<double>(stats.hits)));
+    result.Set("misses", Napi::Number::New(env,
+            static_cast<double>(stats.misses)));
+    result.Set("hitRatio", Napi::Number::New(env, lookups == 0 ? 0 :
+            static_cast<double>(stats.hits) / lookups));
+    result.Set("evictions", Napi::Number::New(env,
+            static_cast<double>(stats.evictions)));
+    result.Set("expirations", Napi::Number::New(env,
+            static_cast<double>(stats.expirations)));
+    result.Set("invalidations", Napi::Number::New(env,
+            static_cast<double>(stats.invalidations)));
+    result.Set("entries", Napi::Number::New(env,
+            static_cast<double>(stats.entries)));
+    result.Set("bytes", Napi::Number::New(env,
+            static_cast<double>(stats.bytes)));
+    result.Set("maxBytes", Napi::Number::New(env,
+            static_cast<double>(stats.maxBytes)));
+    result.Set("ttl", Napi::Number::New(env,
+            static_cast<double>(stats.ttl)));
+    return result;
+}
+
+}  // namespace griddb
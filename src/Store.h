@@ -19,10 +19,16 @@
 
 #include <napi.h>
 #include <limits>
+#include <memory>
 #include "Container.h"
 #include "ContainerInfo.h"
+#include "ContainerSchema.h"
+#include "Metrics.h"
 #include "PartitionController.h"
+#include "PartitionCache.h"
+#include "RowCache.h"
 #include "RowKeyPredicate.h"
+#include "StorePool.h"
 
 #include "Util.h"
 
@@ -48,6 +54,12 @@ class Store: public Napi::ObjectWrap<Store> {
     Napi::Value multiGet(const Napi::CallbackInfo &info);
     Napi::Value createRowKeyPredicate(const Napi::CallbackInfo &info);
     Napi::Value fetchAll(const Napi::CallbackInfo &info);
+    Napi::Value listContainerNames(const Napi::CallbackInfo &info);
+    Napi::Value putContainers(const Napi::CallbackInfo &info);
+    Napi::Value dropContainers(const Napi::CallbackInfo &info);
+    Napi::Value setRowCache(const Napi::CallbackInfo &info);
+    Napi::Value getRowCacheStats(const Napi::CallbackInfo &info);
+    Napi::Value close(const Napi::CallbackInfo &info);
 
     // N-API support methods
     void setReadonlyAttribute(const Napi::CallbackInfo &info,
@@ -55,6 +67,20 @@ class Store: public Napi::ObjectWrap<Store> {
 
  private:
     GSGridStore *mStore;
+    std::shared_ptr<StorePool> mPool;
+    std::shared_ptr<PartitionCache> mPartitionCache;
+    // Rows read by Container.get, shared with Containers of this Store
+    std::shared_ptr<RowCache> mRowCache;
+
+    // Close handles, can be called more than once
+    void release();
+
+    Napi::Value newContainer(Napi::Env env, GSContainer *container,
+            GSContainerInfo *containerInfo);
+
+    Napi::Value multiPutByPartition(Napi::Env env,
+            Napi::Promise::Deferred deferred, Napi::Object objNapi,
+            int concurrency, PhaseTimer *timer);
 };
 
 }  // namespace griddb
@@ -15,6 +15,8 @@
 */
 
 #include "StoreFactory.h"
+#include "Tracing.h"
+#include "Watchdog.h"
 
 namespace griddb {
 
@@ -81,6 +83,7 @@ static bool checkMulticast(const char* address) {
 
 Napi::Value StoreFactory::getStore(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
+    BlockingWatch watch("StoreFactory.getStore", info);
 
     if (info.Length() != 1 || !info[0].IsObject()) {
         THROW_EXCEPTION_WITH_STR(env, "Wrong argument", factory)
@@ -121,16 +124,22 @@ Napi::Value StoreFactory::getStore(const Napi::CallbackInfo& info) {
 
     GSGridStore *store = NULL;
 
+    TraceSpan span("griddb.StoreFactory.getStore");
     GSResult ret = gsGetGridStore(factory, properties, idx, &store);
+    span.setResult(ret);
     ENSURE_SUCCESS(gsGetGridStore, ret, factory)
 
     // Create new Store object
     Napi::EscapableHandleScope scope(env);
     auto storeNode = Napi::External<GSGridStore>::New(env, store);
+    auto poolNode = Napi::External<StorePool>::New(env,
+            new StorePool(properties, idx));
 #if NAPI_VERSION > 5
-    return scope.Escape(Util::getInstanceData(env, "Store")->New( {storeNode})).ToObject();
+    return scope.Escape(Util::getInstanceData(env, "Store")->New(
+            {storeNode, poolNode})).ToObject();
 #else
-    return scope.Escape(Store::constructor.New( {storeNode})).ToObject();
+    return scope.Escape(Store::constructor.New(
+            {storeNode, poolNode})).ToObject();
 #endif
 }
 
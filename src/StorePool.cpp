@@ -0,0 +1,132 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <system_error>
+#include <thread>
+#include "StorePool.h"
+#include "GSException.h"
+#include "Metrics.h"
+
+namespace griddb {
+
+StorePool::StorePool(const GSPropertyEntry *properties,
+        size_t propertyCount) : mClosed(false) {
+    for (size_t i = 0; i < propertyCount; i++) {
+        mProperties.push_back(std::make_pair(
+                std::string(properties[i].name),
+                std::string(properties[i].value)));
+    }
+}
+
+StorePool::~StorePool() {
+    closeIdle();
+}
+
+void StorePool::closeIdle() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (size_t i = 0; i < mIdleList.size(); i++) {
+        gsCloseGridStore(&mIdleList[i], GS_TRUE);
+    }
+    Metrics::addGauge(GAUGE_POOL_HANDLES_IDLE,
+            -static_cast<int64_t>(mIdleList.size()));
+    mIdleList.clear();
+}
+
+void StorePool::close() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mClosed = true;
+    }
+    closeIdle();
+}
+
+/**
+ * @brief Get an idle handle, or open a new one when all handles are in use.
+ * @param **store A pointer stores the handle, owned by the caller until
+ *   release() is called
+ * @return Result of gsGetGridStore when a new handle is opened, error
+ *   after close()
+ */
+GSResult StorePool::acquire(GSGridStore **store) {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mClosed) {
+            *store = NULL;
+            return DEFAULT_ERROR_CODE;
+        }
+        if (!mIdleList.empty()) {
+            *store = mIdleList.back();
+            mIdleList.pop_back();
+            Metrics::addGauge(GAUGE_POOL_HANDLES_IDLE, -1);
+            Metrics::addGauge(GAUGE_POOL_HANDLES_IN_USE, 1);
+            return GS_RESULT_OK;
+        }
+    }
+    std::vector<GSPropertyEntry> properties(mProperties.size());
+    for (size_t i = 0; i < mProperties.size(); i++) {
+        properties[i].name = mProperties[i].first.c_str();
+        properties[i].value = mProperties[i].second.c_str();
+    }
+    *store = NULL;
+    GSResult ret = gsGetGridStore(gsGetDefaultFactory(), properties.data(),
+            properties.size(), store);
+    if (*store != NULL) {
+        Metrics::addGauge(GAUGE_POOL_HANDLES_IN_USE, 1);
+    }
+    return ret;
+}
+
+void StorePool::release(GSGridStore *store) {
+    if (store == NULL) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    Metrics::addGauge(GAUGE_POOL_HANDLES_IN_USE, -1);
+    if (mClosed) {
+        // Worker finished after Store.close()
+        gsCloseGridStore(&store, GS_TRUE);
+        return;
+    }
+    mIdleList.push_back(store);
+    Metrics::addGauge(GAUGE_POOL_HANDLES_IDLE, 1);
+}
+
+/**
+ * @brief Run task for each slot, one thread per slot. Current thread runs
+ *   slot 0 and waits for the others.
+ * @param slotCount Number of slots
+ * @param task Task called with slot index
+ */
+void StorePool::runParallel(size_t slotCount,
+        const std::function<void(size_t)> &task) {
+    std::vector<std::thread> threadList;
+    for (size_t i = 1; i < slotCount; i++) {
+        try {
+            threadList.push_back(std::thread(task, i));
+        } catch (const std::system_error&) {
+            // Can't create more threads, run the slot on current thread
+            task(i);
+        }
+    }
+    if (slotCount > 0) {
+        task(0);
+    }
+    for (size_t i = 0; i < threadList.size(); i++) {
+        threadList[i].join();
+    }
+}
+
+}  // namespace griddb
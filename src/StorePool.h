@@ -0,0 +1,60 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef STOREPOOL_H
+#define STOREPOOL_H
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "gridstore.h"
+
+#define DEFAULT_POOL_CONCURRENCY 4
+#define DEFAULT_CONTAINER_NAME_PAGE_SIZE 10000
+
+namespace griddb {
+
+// Extra GSGridStore handles opened with the same properties as a Store.
+// A GSGridStore must not be used by two threads at the same time, so
+// each worker thread of a parallel operation holds its own handle.
+class StorePool {
+ public:
+    StorePool(const GSPropertyEntry *properties, size_t propertyCount);
+    ~StorePool();
+
+    GSResult acquire(GSGridStore **store);
+    void release(GSGridStore *store);
+    // Close idle handles, handles are opened again on demand
+    void closeIdle();
+    // Close idle handles and stop opening new ones. Handles released
+    // after this are closed instead of pooled
+    void close();
+
+    static void runParallel(size_t slotCount,
+            const std::function<void(size_t)> &task);
+
+ private:
+    std::vector<std::pair<std::string, std::string> > mProperties;
+    std::vector<GSGridStore*> mIdleList;
+    bool mClosed;
+    std::mutex mMutex;
+};
+
+}  // namespace griddb
+
+#endif  // STOREPOOL_H
@@ -0,0 +1,220 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "TopKMerger.h"
+#include <string.h>
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include "Util.h"
+#include "Macro.h"
+
+#define SORT_KIND_STRING 0
+#define SORT_KIND_NUMBER 1
+
+namespace griddb {
+
+static int toSortKind(GSType type) {
+    switch (type) {
+    case GS_TYPE_STRING:
+        return SORT_KIND_STRING;
+    case GS_TYPE_BOOL:
+    case GS_TYPE_BYTE:
+    case GS_TYPE_SHORT:
+    case GS_TYPE_INTEGER:
+    case GS_TYPE_LONG:
+    case GS_TYPE_TIMESTAMP:
+    case GS_TYPE_FLOAT:
+    case GS_TYPE_DOUBLE:
+        return SORT_KIND_NUMBER;
+    default:
+        return -1;
+    }
+}
+
+// NULL is the smallest value
+static int compareField(const FieldValue &a, const FieldValue &b) {
+    if (a.isNull || b.isNull) {
+        return (a.isNull ? 0 : 1) - (b.isNull ? 0 : 1);
+    }
+    bool aFloat = a.type == GS_TYPE_FLOAT || a.type == GS_TYPE_DOUBLE;
+    bool bFloat = b.type == GS_TYPE_FLOAT || b.type == GS_TYPE_DOUBLE;
+    if (a.type == GS_TYPE_STRING) {
+        int result = a.bytes.compare(b.bytes);
+        return (result > 0) - (result < 0);
+    } else if (!aFloat && !bFloat) {
+        return (a.integer > b.integer) - (a.integer < b.integer);
+    }
+    double x = aFloat ? a.number : static_cast<double>(a.integer);
+    double y = bFloat ? b.number : static_cast<double>(b.integer);
+    return (x > y) - (x < y);
+}
+
+TopKMerger::TopKMerger() : mLimit(0), mSequence(0) {
+}
+
+/**
+ * @brief Read options.
+ *   orderBy: column name with optional " ASC" or " DESC", or array of them
+ *   k: number of rows
+ */
+void TopKMerger::setOptions(const Napi::Env &env,
+        const Napi::Value &options) {
+    if (!options.IsObject()) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "Wrong arguments")
+    }
+    Napi::Object obj = options.As<Napi::Object>();
+    Napi::Value k = obj.Get("k");
+    if (!k.IsNumber() || !(k.As<Napi::Number>().DoubleValue() >= 1)) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "k should be positive number")
+    }
+    mLimit = static_cast<size_t>(k.As<Napi::Number>().Int64Value());
+
+    Napi::Value orderBy = obj.Get("orderBy");
+    std::vector<std::string> specList;
+    if (orderBy.IsString()) {
+        specList.push_back(orderBy.As<Napi::String>().Utf8Value());
+    } else if (orderBy.IsArray()) {
+        Napi::Array array = orderBy.As<Napi::Array>();
+        for (uint32_t i = 0; i < array.Length(); i++) {
+            specList.push_back(array.Get(i).ToString().Utf8Value());
+        }
+    }
+    if (specList.empty()) {
+        THROW_CPP_EXCEPTION_WITH_STR(env, "orderBy should be specified")
+    }
+    for (size_t i = 0; i < specList.size(); i++) {
+        std::istringstream stream(specList[i]);
+        SortColumn column;
+        std::string order;
+        stream >> column.name >> order;
+        std::transform(order.begin(), order.end(), order.begin(),
+                [](unsigned char c) { return std::toupper(c); });
+        if (column.name.empty() || !(order.empty() || order == "ASC" ||
+                order == "DESC")) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "Invalid orderBy")
+        }
+        column.descending = order == "DESC";
+        column.kind = -1;
+        mSortColumnList.push_back(column);
+    }
+}
+
+/**
+ * @brief Resolve orderBy columns for rows of schema. Columns must be
+ *   compared in the same way for all sources
+ */
+void TopKMerger::setSource(const Napi::Env &env,
+        const std::shared_ptr<const ContainerSchema> &schema) {
+    mSchema = schema;
+    mKeyColumnList.resize(mSortColumnList.size());
+    for (size_t i = 0; i < mSortColumnList.size(); i++) {
+        SortColumn &column = mSortColumnList[i];
+        int columnIndex = schema->columnIndex(column.name);
+        if (columnIndex < 0) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "Column not found")
+        }
+        int kind = toSortKind(schema->columnType(columnIndex));
+        if (kind < 0 || (column.kind >= 0 && column.kind != kind)) {
+            THROW_CPP_EXCEPTION_WITH_STR(env, "Invalid type of orderBy column")
+        }
+        column.kind = kind;
+        mKeyColumnList[i] = columnIndex;
+    }
+}
+
+// Negative if a comes before b
+int TopKMerger::compare(const Entry &a, const Entry &b) const {
+    for (size_t i = 0; i < mSortColumnList.size(); i++) {
+        int result = compareField(a.key[i], b.key[i]);
+        if (result != 0) {
+            return mSortColumnList[i].descending ? -result : result;
+        }
+    }
+    // Keep order of arrival for same keys
+    return (a.sequence > b.sequence) - (a.sequence < b.sequence);
+}
+
+GSResult TopKMerger::copyRow(GSRow *row, Entry *entry) const {
+    size_t columnCount = mSchema->columnCount();
+    entry->row.resize(columnCount);
+    entry->schema = mSchema;
+    for (size_t i = 0; i < columnCount; i++) {
+        GSResult ret = readFieldValue(row, static_cast<int>(i),
+                mSchema->columnType(i), &entry->row[i]);
+        if (!GS_SUCCEEDED(ret)) {
+            return ret;
+        }
+    }
+    return GS_RESULT_OK;
+}
+
+/**
+ * @brief Offer row of current source. Row is copied only if it is in the
+ *   first K rows so far
+ */
+GSResult TopKMerger::offer(GSRow *row) {
+    if (mLimit == 0) {
+        return GS_RESULT_OK;
+    }
+    // Heap top is the last of kept rows
+    auto comparator = [this](const Entry &a, const Entry &b) {
+        return compare(a, b) < 0;
+    };
+    mCandidate.key.resize(mKeyColumnList.size());
+    for (size_t i = 0; i < mKeyColumnList.size(); i++) {
+        GSResult ret = readFieldValue(row, mKeyColumnList[i],
+                mSchema->columnType(mKeyColumnList[i]), &mCandidate.key[i]);
+        if (!GS_SUCCEEDED(ret)) {
+            return ret;
+        }
+    }
+    mCandidate.sequence = mSequence++;
+    if (mHeap.size() == mLimit) {
+        if (compare(mCandidate, mHeap.front()) >= 0) {
+            return GS_RESULT_OK;
+        }
+        std::pop_heap(mHeap.begin(), mHeap.end(), comparator);
+        mHeap.pop_back();
+    }
+    GSResult ret = copyRow(row, &mCandidate);
+    if (!GS_SUCCEEDED(ret)) {
+        return ret;
+    }
+    mHeap.push_back(mCandidate);
+    std::push_heap(mHeap.begin(), mHeap.end(), comparator);
+    return GS_RESULT_OK;
+}
+
+Napi::Value TopKMerger::toArray(const Napi::Env &env) {
+    std::sort_heap(mHeap.begin(), mHeap.end(),
+            [this](const Entry &a, const Entry &b) {
+                return compare(a, b) < 0;
+            });
+    Napi::Array result = Napi::Array::New(env, mHeap.size());
+    for (size_t i = 0; i < mHeap.size(); i++) {
+        const Entry &entry = mHeap[i];
+        Napi::Array row = Napi::Array::New(env, entry.row.size());
+        for (size_t j = 0; j < entry.row.size(); j++) {
+            row.Set(static_cast<uint32_t>(j), toNapiValue(env, entry.row[j]));
+        }
+        result.Set(static_cast<uint32_t>(i), row);
+    }
+    mHeap.clear();
+    return result;
+}
+
+}  // namespace griddb
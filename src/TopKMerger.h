@@ -0,0 +1,75 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef TOPKMERGER_H
+#define TOPKMERGER_H
+
+#include <napi.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ContainerSchema.h"
+#include "FieldValue.h"
+#include "gridstore.h"
+
+namespace griddb {
+
+// Keep the first K rows in order of orderBy columns among rows of one or
+// more sources, with a bounded heap. Only rows in the heap are copied,
+// and only the final rows are converted to JS values
+class TopKMerger {
+ public:
+    TopKMerger();
+
+    // Read options {orderBy, k}. Throw Napi::Error
+    void setOptions(const Napi::Env &env, const Napi::Value &options);
+    // Set schema of next rows. Throw Napi::Error
+    void setSource(const Napi::Env &env,
+            const std::shared_ptr<const ContainerSchema> &schema);
+    GSResult offer(GSRow *row);
+    // Rows in order. Throw Napi::Error
+    Napi::Value toArray(const Napi::Env &env);
+
+ private:
+    struct SortColumn {
+        std::string name;
+        bool descending;
+        // Key is compared as string or as number
+        int kind;
+    };
+
+    struct Entry {
+        std::vector<FieldValue> key;
+        std::vector<FieldValue> row;
+        std::shared_ptr<const ContainerSchema> schema;
+        uint64_t sequence;
+    };
+
+    std::vector<SortColumn> mSortColumnList;
+    size_t mLimit;
+    std::shared_ptr<const ContainerSchema> mSchema;
+    std::vector<int> mKeyColumnList;
+    std::vector<Entry> mHeap;
+    Entry mCandidate;
+    uint64_t mSequence;
+
+    int compare(const Entry &a, const Entry &b) const;
+    GSResult copyRow(GSRow *row, Entry *entry) const;
+};
+
+}  // namespace griddb
+
+#endif  // TOPKMERGER_H
@@ -0,0 +1,181 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Tracing.h"
+#include <utility>
+#include "Metrics.h"
+#include "GSException.h"
+#include "Macro.h"
+
+namespace griddb {
+
+std::atomic<bool> Tracing::sEnabled(false);
+std::mutex Tracing::sMutex;
+std::deque<TraceRecord> Tracing::sRecordList;
+size_t Tracing::sBufferSize = TRACE_DEFAULT_BUFFER_SIZE;
+uint64_t Tracing::sDropped = 0;
+int64_t Tracing::sOrigin = 0;
+
+TraceSpan::TraceSpan(const char *name) :
+        mActive(Tracing::enabled()), mStartBytes(0) {
+    mRecord.name = name;
+    mRecord.rows = -1;
+    mRecord.bytes = 0;
+    mRecord.result = GS_RESULT_OK;
+    if (mActive) {
+        mStartBytes = Metrics::threadBytes();
+        mRecord.startTime = Metrics::now();
+    }
+}
+
+TraceSpan::~TraceSpan() {
+    if (!mActive) {
+        return;
+    }
+    mRecord.endTime = Metrics::now();
+    mRecord.bytes = Metrics::threadBytes() - mStartBytes;
+    Tracing::record(&mRecord);
+}
+
+bool TraceSpan::active() const {
+    return mActive;
+}
+
+void TraceSpan::setContainer(const std::string &name) {
+    if (mActive) {
+        mRecord.container = name;
+    }
+}
+
+void TraceSpan::setRows(int64_t rows) {
+    mRecord.rows = rows;
+}
+
+void TraceSpan::setResult(GSResult ret) {
+    mRecord.result = ret;
+}
+
+void Tracing::init(Napi::Env env, Napi::Object exports) {
+    Napi::Object tracing = Napi::Object::New(env);
+    tracing.Set("start", Napi::Function::New(env, &Tracing::start, "start"));
+    tracing.Set("stop", Napi::Function::New(env, &Tracing::stop, "stop"));
+    tracing.Set("drain", Napi::Function::New(env, &Tracing::drain, "drain"));
+    exports.Set("tracing", tracing);
+}
+
+bool Tracing::enabled() {
+    return sEnabled.load(std::memory_order_relaxed);
+}
+
+void Tracing::record(TraceRecord *record) {
+    std::lock_guard<std::mutex> lock(sMutex);
+    if (!enabled()) {
+        return;
+    }
+    if (sRecordList.size() >= sBufferSize) {
+        sRecordList.pop_front();
+        sDropped++;
+    }
+    sRecordList.push_back(TraceRecord());
+    std::swap(sRecordList.back(), *record);
+}
+
+/**
+ * @brief Start recording spans
+ * @param info[0] performance.now() of caller, maps span times to the
+ *   performance timeline
+ * @param info[1] Maximum spans kept between drains
+ */
+Napi::Value Tracing::start(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() != 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
+        return env.Undefined();
+    }
+    int64_t bufferSize = info[1].As<Napi::Number>().Int64Value();
+    if (bufferSize <= 0) {
+        THROW_EXCEPTION_WITH_STR(env, "bufferSize should be positive", NULL)
+        return env.Undefined();
+    }
+    std::lock_guard<std::mutex> lock(sMutex);
+    sOrigin = Metrics::now() - static_cast<int64_t>(
+            info[0].As<Napi::Number>().DoubleValue() * NANOS_PER_MILLI);
+    sBufferSize = static_cast<size_t>(bufferSize);
+    while (sRecordList.size() > sBufferSize) {
+        sRecordList.pop_front();
+        sDropped++;
+    }
+    sEnabled.store(true, std::memory_order_relaxed);
+    return env.Undefined();
+}
+
+Napi::Value Tracing::stop(const Napi::CallbackInfo &info) {
+    sEnabled.store(false, std::memory_order_relaxed);
+    return info.Env().Undefined();
+}
+
+/**
+ * @brief Remove buffered spans
+ * @return {spans: [{name, startTime, duration, detail}], dropped}. Times are
+ *   milliseconds of the performance timeline. detail has container, rows,
+ *   bytes and error code when known. dropped is the number of spans lost
+ *   to a full buffer since last drain
+ */
+Napi::Value Tracing::drain(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    std::deque<TraceRecord> recordList;
+    uint64_t dropped;
+    int64_t origin;
+    {
+        std::lock_guard<std::mutex> lock(sMutex);
+        recordList.swap(sRecordList);
+        dropped = sDropped;
+        sDropped = 0;
+        origin = sOrigin;
+    }
+    Napi::Array spans = Napi::Array::New(env, recordList.size());
+    for (size_t i = 0; i < recordList.size(); i++) {
+        const TraceRecord &record = recordList[i];
+        Napi::Object detail = Napi::Object::New(env);
+        if (!record.container.empty()) {
+            detail.Set("container", record.container);
+        }
+        if (record.rows >= 0) {
+            detail.Set("rows", Napi::Number::New(env,
+                    static_cast<double>(record.rows)));
+        }
+        detail.Set("bytes", Napi::Number::New(env,
+                static_cast<double>(record.bytes)));
+        if (!GS_SUCCEEDED(record.result)) {
+            detail.Set("error", Napi::Number::New(env, record.result));
+        }
+        Napi::Object span = Napi::Object::New(env);
+        span.Set("name", record.name);
+        span.Set("startTime", Napi::Number::New(env,
+                (record.startTime - origin) / NANOS_PER_MILLI));
+        span.Set("duration", Napi::Number::New(env,
+                (record.endTime - record.startTime) / NANOS_PER_MILLI));
+        span.Set("detail", detail);
+        spans.Set(static_cast<uint32_t>(i), span);
+    }
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("spans", spans);
+    result.Set("dropped", Napi::Number::New(env,
+            static_cast<double>(dropped)));
+    return result;
+}
+
+}  // namespace griddb
@@ -0,0 +1,94 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <napi.h>
+#include <stdint.h>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include "gridstore.h"
+
+// Spans kept between drains by default, oldest are dropped when full
+#define TRACE_DEFAULT_BUFFER_SIZE 4096
+
+namespace griddb {
+
+// One finished binding operation
+struct TraceRecord {
+    const char *name;
+    int64_t startTime;
+    int64_t endTime;
+    std::string container;
+    // -1 when the operation has no row count
+    int64_t rows;
+    uint64_t bytes;
+    GSResult result;
+};
+
+// Span of one binding operation on the stack. Recorded when destroyed,
+// does nothing unless tracing is enabled
+class TraceSpan {
+ public:
+    explicit TraceSpan(const char *name);
+    ~TraceSpan();
+
+    bool active() const;
+    void setContainer(const std::string &name);
+    void setRows(int64_t rows);
+    void setResult(GSResult ret);
+
+ private:
+    TraceSpan(const TraceSpan&);
+    TraceSpan& operator=(const TraceSpan&);
+
+    bool mActive;
+    uint64_t mStartBytes;
+    TraceRecord mRecord;
+};
+
+// Process wide buffer of spans, drained by griddb.tracing in JS into
+// performance measures
+class Tracing {
+ public:
+    static void init(Napi::Env env, Napi::Object exports);
+
+    static bool enabled();
+    static void record(TraceRecord *record);
+
+    // griddb.tracing.start(performanceNow, bufferSize)
+    static Napi::Value start(const Napi::CallbackInfo &info);
+    // griddb.tracing.stop()
+    static Napi::Value stop(const Napi::CallbackInfo &info);
+    // griddb.tracing.drain(): buffered spans, oldest first
+    static Napi::Value drain(const Napi::CallbackInfo &info);
+
+ private:
+    static std::atomic<bool> sEnabled;
+    static std::mutex sMutex;
+    static std::deque<TraceRecord> sRecordList;
+    static size_t sBufferSize;
+    static uint64_t sDropped;
+    // Metrics::now() at time origin of performance.now()
+    static int64_t sOrigin;
+};
+
+}  // namespace griddb
+
+#endif  // TRACING_H
@@ -17,6 +17,8 @@
 #include <string>
 #include <limits>
 #include "Util.h"
+#include "ExternalMemory.h"
+#include "Metrics.h"
 #include "Macro.h"
 #include "GSException.h"
 
@@ -82,6 +84,9 @@ static Napi::Value fromFieldAsString(const Napi::Env& env, GSRow* row,
     GSResult ret = gsGetRowFieldAsString(row, (int32_t) column,
             (const GSChar**) &stringValue);
     ENSURE_SUCCESS_CPP(Util::fromFieldAsString, ret)
+    if (stringValue != NULL) {
+        griddb::Metrics::add(griddb::COUNTER_BYTES_READ, strlen(stringValue));
+    }
     if ((stringValue != NULL) && (stringValue[0] == '\0')) {
         // Empty string
         if (isNull(row, column)) {
@@ -95,24 +100,36 @@ static Napi::Value fromFieldAsString(const Napi::Env& env, GSRow* row,
     }
 }
 
+/**
+ * @brief Buffer with a copy of blob, counted as external memory until
+ *   the Buffer is collected
+ */
+static Napi::Value newBlobBuffer(const Napi::Env& env, const GSBlob &blob) {
+    size_t size = blob.size;
+    char *data = new char[size + 1];
+    if (size > 0) {
+        memcpy(data, blob.data, size);
+    }
+    griddb::ExternalMemory::add(env, griddb::MEMORY_BLOB, size);
+    return Napi::Buffer<char>::New(env, data, size,
+            [size](Napi::Env env, char *data) {
+                griddb::ExternalMemory::remove(env, griddb::MEMORY_BLOB,
+                        size);
+                delete[] data;
+            });
+}
+
 static Napi::Value fromFieldAsBlob(const Napi::Env& env, GSRow* row,
        int column) {
     GSBlob blobValue;
     GSResult ret = gsGetRowFieldAsBlob(row, (int32_t) column, &blobValue);
     ENSURE_SUCCESS_CPP(Util::fromFieldAsBlob, ret)
-    const GSChar* string;
-    if (blobValue.size) {
-        string = Util::strdup((const GSChar *) blobValue.data);
-        return Napi::Buffer<char>::New(env, const_cast<char*>(string),
-                blobValue.size, Util::freeStrData);
-    } else if (isNull(row, column)) {
+    griddb::Metrics::add(griddb::COUNTER_BYTES_READ, blobValue.size);
+    if (!blobValue.size && isNull(row, column)) {
         // NULL value
         return env.Null();
-    } else {
-        string = Util::strdup((const GSChar *) blobValue.data);
-        return Napi::Buffer<char>::New(env, const_cast<char*>(string),
-                blobValue.size, Util::freeStrData);
     }
+    return newBlobBuffer(env, blobValue);
 }
 
 static Napi::Value fromFieldAsBool(const Napi::Env& env, GSRow* row,
@@ -227,6 +244,9 @@ static Napi::Value fromFieldAsGeometry(const Napi::Env& env, GSRow* row,
     GSResult ret = gsGetRowFieldAsGeometry(row, (int32_t) column,
             (const GSChar**) &geoValue);
     ENSURE_SUCCESS_CPP(Util::fromFieldAsGeometry, ret)
+    if (geoValue != NULL) {
+        griddb::Metrics::add(griddb::COUNTER_BYTES_READ, strlen(geoValue));
+    }
     if ((geoValue != NULL) && (geoValue[0] == '\0')) {
         // Empty string
         if (isNull(row, column)) {
@@ -240,46 +260,49 @@ static Napi::Value fromFieldAsGeometry(const Napi::Env& env, GSRow* row,
     }
 }
 
-Napi::Value Util::fromField(const Napi::Env& env, GSRow* row, int column,
-        GSType type) {
+static Napi::Value fromFieldAsUnsupported(const Napi::Env& env, GSRow* row,
+        int column) {
+    THROW_CPP_EXCEPTION_WITH_STR(env, "Type is not support.")
+    return env.Null();
+}
+
+/**
+ * @brief Get converter from GSRow field of type to Napi::Value
+ * @param type Column type
+ * @return Converter, which throws for not supported type
+ */
+Util::FromFieldFunc Util::fromFieldFunc(GSType type) {
     switch (type) {
         case GS_TYPE_LONG:
-            return fromFieldAsLong(env, row, column);
-            break;
+            return fromFieldAsLong;
         case GS_TYPE_STRING:
-            return fromFieldAsString(env, row, column);
-            break;
+            return fromFieldAsString;
         case GS_TYPE_BLOB:
-            return fromFieldAsBlob(env, row, column);
-            break;
+            return fromFieldAsBlob;
         case GS_TYPE_BOOL:
-            return fromFieldAsBool(env, row, column);
-            break;
+            return fromFieldAsBool;
         case GS_TYPE_INTEGER:
-            return fromFieldAsInteger(env, row, column);
-            break;
+            return fromFieldAsInteger;
         case GS_TYPE_FLOAT:
-            return fromFieldAsFloat(env, row, column);
-            break;
+            return fromFieldAsFloat;
         case GS_TYPE_DOUBLE:
-            return fromFieldAsDouble(env, row, column);
-            break;
+            return fromFieldAsDouble;
         case GS_TYPE_TIMESTAMP:
-            return fromFieldAsTimestamp(env, row, column);
-            break;
+            return fromFieldAsTimestamp;
         case GS_TYPE_BYTE:
-            return fromFieldAsByte(env, row, column);
-            break;
+            return fromFieldAsByte;
         case GS_TYPE_SHORT:
-            return fromFieldAsShort(env, row, column);
-            break;
+            return fromFieldAsShort;
         case GS_TYPE_GEOMETRY:
-            return fromFieldAsGeometry(env, row, column);
-            break;
+            return fromFieldAsGeometry;
         default:
-            THROW_CPP_EXCEPTION_WITH_STR(env, "Type is not support.")
+            return fromFieldAsUnsupported;
         }
-    return env.Null();
+}
+
+Napi::Value Util::fromField(const Napi::Env& env, GSRow* row, int column,
+        GSType type) {
+    return fromFieldFunc(type)(env, row, column);
 }
 
 Napi::Value Util::fromTimestamp(const Napi::Env& env, GSTimestamp *timestamp) {
@@ -300,6 +323,7 @@ static void toFieldAsString(const Napi::Env &env, Napi::Value *value,
     stringVal = value->As<Napi::String>().Utf8Value();
     GSResult ret = gsSetRowFieldByString(row, column, stringVal.c_str());
     ENSURE_SUCCESS_CPP(Util::toFieldAsString, ret)
+    griddb::Metrics::add(griddb::COUNTER_BYTES_WRITTEN, stringVal.size());
 }
 
 static void toFieldAsLong(const Napi::Env &env, Napi::Value *value, GSRow *row,
@@ -455,68 +479,60 @@ static void toFieldAsBlob(const Napi::Env &env, Napi::Value *value, GSRow *row,
     blobVal.size = size;
     GSBool ret = gsSetRowFieldByBlob(row, column, (const GSBlob*) &blobVal);
     ENSURE_SUCCESS_CPP(Util::toFieldAsBlob, ret)
+    griddb::Metrics::add(griddb::COUNTER_BYTES_WRITTEN, size);
 }
 
-static void toFieldAsNull(const Napi::Env &env, Napi::Value *value,
+void Util::toFieldAsNull(const Napi::Env &env, Napi::Value *value,
         GSRow *row, int column) {
     GSResult ret = gsSetRowFieldNull(row, column);
     ENSURE_SUCCESS_CPP(Util::toFieldAsNull, ret)
 }
 
+static void toFieldAsUnsupported(const Napi::Env &env, Napi::Value *value,
+        GSRow *row, int column) {
+    THROW_CPP_EXCEPTION_WITH_STR(env, "Type is not support")
+}
+
+/**
+ * @brief Get converter from Napi::Value to GSRow field of type.
+ *   Null and undefined values are not handled by the converter.
+ * @param type Column type
+ * @return Converter, which throws for not supported type
+ */
+Util::ToFieldFunc Util::toFieldFunc(GSType type) {
+    switch (type) {
+    case GS_TYPE_STRING:
+        return toFieldAsString;
+    case GS_TYPE_LONG:
+        return toFieldAsLong;
+    case GS_TYPE_BOOL:
+        return toFieldAsBool;
+    case GS_TYPE_BYTE:
+        return toFieldAsByte;
+    case GS_TYPE_SHORT:
+        return toFieldAsShort;
+    case GS_TYPE_INTEGER:
+        return toFieldAsInteger;
+    case GS_TYPE_FLOAT:
+        return toFieldAsFloat;
+    case GS_TYPE_DOUBLE:
+        return toFieldAsDouble;
+    case GS_TYPE_TIMESTAMP:
+        return toFieldAsTimestamp;
+    case GS_TYPE_BLOB:
+        return toFieldAsBlob;
+    default:
+        return toFieldAsUnsupported;
+    }
+}
+
 void Util::toField(const Napi::Env &env, Napi::Value *value, GSRow *row,
         int column, GSType type) {
     if (value->IsNull() || value->IsUndefined()) {
         toFieldAsNull(env, value, row, column);
         return;
     }
-    switch (type) {
-    case GS_TYPE_STRING: {
-        toFieldAsString(env, value, row, column);
-        break;
-    }
-    case GS_TYPE_LONG: {
-        toFieldAsLong(env, value, row, column);
-        break;
-    }
-    case GS_TYPE_BOOL: {
-        toFieldAsBool(env, value, row, column);
-        break;
-    }
-    case GS_TYPE_BYTE: {
-        toFieldAsByte(env, value, row, column);
-        break;
-    }
-
-    case GS_TYPE_SHORT: {
-        toFieldAsShort(env, value, row, column);
-        break;
-    }
-    case GS_TYPE_INTEGER: {
-        toFieldAsInteger(env, value, row, column);
-        break;
-    }
-    case GS_TYPE_FLOAT: {
-        toFieldAsFloat(env, value, row, column);
-        break;
-    }
-    case GS_TYPE_DOUBLE: {
-        toFieldAsDouble(env, value, row, column);
-        break;
-    }
-
-    case GS_TYPE_TIMESTAMP: {
-        toFieldAsTimestamp(env, value, row, column);
-        break;
-    }
-
-    case GS_TYPE_BLOB: {
-        toFieldAsBlob(env, value, row, column);
-        break;
-    }
-    default:
-        THROW_CPP_EXCEPTION_WITH_STR(env, "Type is not support")
-        break;
-    }
+    toFieldFunc(type)(env, value, row, column);
 }
 
 void Util::setInstanceData(Napi::Env env, std::string key,
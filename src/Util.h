@@ -33,6 +33,12 @@ typedef std::map<std::string, Napi::FunctionReference*> AddonData;
 
 class Util {
  public:
+    // Converters for one column type, see fromFieldFunc()/toFieldFunc()
+    typedef Napi::Value (*FromFieldFunc)(const Napi::Env &env, GSRow *row,
+            int column);
+    typedef void (*ToFieldFunc)(const Napi::Env &env, Napi::Value *value,
+            GSRow *row, int column);
+
     static const GSChar* strdup(const GSChar *from);
 
     // Convert data from Napi::Value to GSRow field
@@ -48,6 +54,10 @@ class Util {
             GSType type);
     static Napi::Value fromTimestamp(const Napi::Env& env,
             GSTimestamp *timestamp);
+    static FromFieldFunc fromFieldFunc(GSType type);
+    static ToFieldFunc toFieldFunc(GSType type);
+    static void toFieldAsNull(const Napi::Env &env, Napi::Value *value,
+            GSRow *row, int column);
 
     // Other support methods
     static void freeStrData(Napi::Env env, void* data);
@@ -0,0 +1,212 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Watchdog.h"
+#include <cstdio>
+#include "Metrics.h"
+#include "GSException.h"
+#include "Macro.h"
+
+namespace griddb {
+
+std::atomic<bool> Watchdog::sEnabled(false);
+std::atomic<int64_t> Watchdog::sThreshold(0);
+std::mutex Watchdog::sMutex;
+std::deque<BlockingReport> Watchdog::sReportList;
+std::map<std::string, BlockingStats> Watchdog::sStatsMap;
+
+BlockingWatch::BlockingWatch(const char *method,
+        const Napi::CallbackInfo &info) :
+        mMethod(method), mInfo(info),
+        mStartTime(Watchdog::enabled() ? Metrics::now() : 0) {
+}
+
+BlockingWatch::~BlockingWatch() {
+    if (mStartTime == 0) {
+        return;
+    }
+    int64_t duration = Metrics::now() - mStartTime;
+    if (duration >= Watchdog::threshold()) {
+        Watchdog::report(mMethod, duration, mInfo);
+    }
+}
+
+void Watchdog::init(Napi::Env env, Napi::Object exports) {
+    Napi::Object watchdog = Napi::Object::New(env);
+    watchdog.Set("start", Napi::Function::New(env, &Watchdog::start,
+            "start"));
+    watchdog.Set("stop", Napi::Function::New(env, &Watchdog::stop, "stop"));
+    watchdog.Set("drain", Napi::Function::New(env, &Watchdog::drain,
+            "drain"));
+    watchdog.Set("stats", Napi::Function::New(env, &Watchdog::stats,
+            "stats"));
+    exports.Set("watchdog", watchdog);
+}
+
+bool Watchdog::enabled() {
+    return sEnabled.load(std::memory_order_relaxed);
+}
+
+int64_t Watchdog::threshold() {
+    return sThreshold.load(std::memory_order_relaxed);
+}
+
+void Watchdog::report(const char *method, int64_t duration,
+        const Napi::CallbackInfo &info) {
+    std::string args = summarize(info);
+    std::lock_guard<std::mutex> lock(sMutex);
+    BlockingStats &stats = sStatsMap[method];
+    stats.count++;
+    stats.total += duration;
+    if (duration > stats.max) {
+        stats.max = duration;
+    }
+    if (sReportList.size() >= WATCHDOG_REPORT_BUFFER_SIZE) {
+        sReportList.pop_front();
+    }
+    BlockingReport report;
+    report.method = method;
+    report.duration = duration;
+    report.args.swap(args);
+    sReportList.push_back(report);
+}
+
+/**
+ * @brief Short description of arguments, without calling into JS. Empty
+ *   when the call is throwing
+ */
+std::string Watchdog::summarize(const Napi::CallbackInfo &info) {
+    std::string summary;
+    if (info.Env().IsExceptionPending()) {
+        return summary;
+    }
+    char buffer[32];
+    for (size_t i = 0; i < info.Length(); i++) {
+        if (i > 0) {
+            summary += ", ";
+        }
+        Napi::Value value = info[i];
+        if (value.IsString()) {
+            std::string str = value.As<Napi::String>().Utf8Value();
+            summary += '"';
+            if (str.size() > WATCHDOG_MAX_STRING_LENGTH) {
+                summary.append(str, 0, WATCHDOG_MAX_STRING_LENGTH);
+                summary += "...";
+            } else {
+                summary += str;
+            }
+            summary += '"';
+        } else if (value.IsNumber()) {
+            snprintf(buffer, sizeof(buffer), "%g",
+                    value.As<Napi::Number>().DoubleValue());
+            summary += buffer;
+        } else if (value.IsBoolean()) {
+            summary += value.As<Napi::Boolean>().Value() ? "true" : "false";
+        } else if (value.IsNull()) {
+            summary += "null";
+        } else if (value.IsUndefined()) {
+            summary += "undefined";
+        } else if (value.IsBuffer()) {
+            snprintf(buffer, sizeof(buffer), "Buffer(%zu)",
+                    value.As<Napi::Buffer<char> >().Length());
+            summary += buffer;
+        } else if (value.IsArray()) {
+            snprintf(buffer, sizeof(buffer), "Array(%u)",
+                    value.As<Napi::Array>().Length());
+            summary += buffer;
+        } else if (value.IsFunction()) {
+            summary += "Function";
+        } else {
+            summary += "Object";
+        }
+    }
+    return summary;
+}
+
+/**
+ * @brief Start reporting binding calls slower than threshold
+ * @param info[0] Threshold in milliseconds
+ */
+Napi::Value Watchdog::start(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() != 1 || !info[0].IsNumber()) {
+        THROW_EXCEPTION_WITH_STR(env, "Wrong arguments", NULL)
+        return env.Undefined();
+    }
+    double threshold = info[0].As<Napi::Number>().DoubleValue();
+    if (!(threshold >= 0)) {
+        THROW_EXCEPTION_WITH_STR(env, "threshold should not be negative",
+                NULL)
+        return env.Undefined();
+    }
+    sThreshold.store(static_cast<int64_t>(threshold * NANOS_PER_MILLI),
+            std::memory_order_relaxed);
+    sEnabled.store(true, std::memory_order_relaxed);
+    return env.Undefined();
+}
+
+Napi::Value Watchdog::stop(const Napi::CallbackInfo &info) {
+    sEnabled.store(false, std::memory_order_relaxed);
+    return info.Env().Undefined();
+}
+
+/**
+ * @brief Remove reports of slow calls
+ * @return [{method, duration, args}], duration in milliseconds, args is a
+ *   short description of arguments
+ */
+Napi::Value Watchdog::drain(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    std::deque<BlockingReport> reportList;
+    {
+        std::lock_guard<std::mutex> lock(sMutex);
+        reportList.swap(sReportList);
+    }
+    Napi::Array result = Napi::Array::New(env, reportList.size());
+    for (size_t i = 0; i < reportList.size(); i++) {
+        Napi::Object report = Napi::Object::New(env);
+        report.Set("method", reportList[i].method);
+        report.Set("duration", Napi::Number::New(env,
+                reportList[i].duration / NANOS_PER_MILLI));
+        report.Set("args", reportList[i].args);
+        result.Set(static_cast<uint32_t>(i), report);
+    }
+    return result;
+}
+
+/**
+ * @brief Totals of slow calls since the process started
+ * @return {method: {count, total, max}}, times in milliseconds
+ */
+Napi::Value Watchdog::stats(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    Napi::Object result = Napi::Object::New(env);
+    std::lock_guard<std::mutex> lock(sMutex);
+    for (std::map<std::string, BlockingStats>::const_iterator it =
+            sStatsMap.begin(); it != sStatsMap.end(); ++it) {
+        Napi::Object stats = Napi::Object::New(env);
+        stats.Set("count", Napi::Number::New(env,
+                static_cast<double>(it->second.count)));
+        stats.Set("total", Napi::Number::New(env,
+                it->second.total / NANOS_PER_MILLI));
+        stats.Set("max", Napi::Number::New(env,
+                it->second.max / NANOS_PER_MILLI));
+        result.Set(it->first, stats);
+    }
+    return result;
+}
+
+}  // namespace griddb
@@ -0,0 +1,96 @@
+/*
+    Copyright (c) 2020 TOSHIBA Digital Solutions Corporation.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+#include <napi.h>
+#include <stdint.h>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+
+// Slow calls kept between drains, oldest are dropped when full
+#define WATCHDOG_REPORT_BUFFER_SIZE 1024
+// Characters of string arguments kept in reports
+#define WATCHDOG_MAX_STRING_LENGTH 64
+
+namespace griddb {
+
+// One binding call slower than the threshold
+struct BlockingReport {
+    const char *method;
+    int64_t duration;
+    std::string args;
+};
+
+// Totals of slow calls of one method
+struct BlockingStats {
+    uint64_t count;
+    int64_t total;
+    int64_t max;
+};
+
+// Measures wall time of a binding call running on the JS thread, from
+// construction to destruction. Does nothing unless the watchdog is enabled
+class BlockingWatch {
+ public:
+    BlockingWatch(const char *method, const Napi::CallbackInfo &info);
+    ~BlockingWatch();
+
+ private:
+    BlockingWatch(const BlockingWatch&);
+    BlockingWatch& operator=(const BlockingWatch&);
+
+    const char *mMethod;
+    const Napi::CallbackInfo &mInfo;
+    int64_t mStartTime;
+};
+
+// Process wide reports of binding calls blocking the event loop
+class Watchdog {
+ public:
+    static void init(Napi::Env env, Napi::Object exports);
+
+    static bool enabled();
+    static int64_t threshold();
+    static void report(const char *method, int64_t duration,
+            const Napi::CallbackInfo &info);
+
+    // griddb.watchdog.start(thresholdMs)
+    static Napi::Value start(const Napi::CallbackInfo &info);
+    // griddb.watchdog.stop()
+    static Napi::Value stop(const Napi::CallbackInfo &info);
+    // griddb.watchdog.drain(): slow calls since last drain, oldest first
+    static Napi::Value drain(const Napi::CallbackInfo &info);
+    // griddb.watchdog.stats(): totals of slow calls by method
+    static Napi::Value stats(const Napi::CallbackInfo &info);
+
+ private:
+    static std::string summarize(const Napi::CallbackInfo &info);
+
+    static std::atomic<bool> sEnabled;
+    static std::atomic<int64_t> sThreshold;
+    static std::mutex sMutex;
+    static std::deque<BlockingReport> sReportList;
+    static std::map<std::string, BlockingStats> sStatsMap;
+};
+
+}  // namespace griddb
+
+#endif  // WATCHDOG_H